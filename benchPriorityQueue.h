@@ -0,0 +1,1559 @@
+/***********************************************************************
+ * Header:
+ *    BENCH PRIORITY QUEUE
+ * Summary:
+ *    Timing harness for the priority queue. Build with BENCHMARK
+ *    defined (and optimizations on) to run it from main(). Define
+ *    BENCHMARK_HUGE as well for the heaps of several GB.
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef BENCHMARK
+
+#include "priority_queue.h"
+#include "stable_priority_queue.h"
+#include "indexed_priority_queue.h"
+#include "lazy_priority_queue.h"
+#include "keyed_priority_queue.h"
+#include "split_priority_queue.h"
+#include "minmax_heap.h"
+#include "pairing_heap.h"
+#include "radix_heap.h"
+
+#include <chrono>    // for std::chrono::steady_clock
+#include <cstdint>   // for uint32_t and uint64_t
+#include <iostream>  // for std::cout
+#include <iomanip>   // for std::setw
+#include <random>    // for std::mt19937
+#include <string>    // for std::string
+#include <type_traits> // for std::is_same
+#include <vector>    // for std::vector
+
+#ifdef __linux__
+#include <linux/perf_event.h>  // for the branch miss counter
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+class BenchPQueue
+{
+public:
+   // numItems is the workload size, and the largest size in the sweeps.
+   // The top-k streams are ten times as long
+   BenchPQueue(size_t numItems = 1000000) : numItems(numItems), checksum(0) {}
+
+   void run()
+   {
+      std::cout << "PQueue benchmarks, " << numItems << " items\n";
+
+      // Compare
+      bench_minHeap_greater();
+      bench_minHeap_wrapper();
+
+      // Stable ties
+      for (size_t num = numItems / 100; num <= numItems; num *= 100)
+      {
+         bench_stable_wrapper(num);
+         bench_stable<JobLess>(num, "any Compare");
+         bench_stable<custom::compare_by<JobPriority> >(num, "packed key");
+      }
+
+      // Construct
+      bench_build_heapify();
+      bench_build_push();
+
+      // Pop strategy
+      bench_pop_strategy<custom::pop_top_down >("pop top down, string keys");
+      bench_pop_strategy<custom::pop_bottom_up>("pop bottom up, string keys");
+
+      // Derived keys
+      bench_projection_compareBy();
+      bench_projection_keyed();
+
+      // Payload size
+      bench_payload<8>();
+      bench_payload<32>();
+      bench_payload<128>();
+      bench_payload<512>();
+
+      // Bounded top-k stream
+      bench_topK_popPush();
+      bench_topK_replaceTop();
+      bench_topK_pushPop();
+
+      // Batches
+      for (size_t divisor = 4096; divisor >= 1; divisor /= 4)
+         bench_pushRange_crossover(divisor);
+      bench_pushRange_batches();
+      bench_push_batches();
+
+      // Merge
+      for (size_t divisor = 1024; divisor >= 1; divisor /= 32)
+      {
+         bench_merge_popPush(divisor);
+         bench_merge(divisor, false /*isBigIntoSmall*/);
+         bench_merge(divisor, true  /*isBigIntoSmall*/);
+         bench_meld_pairing(divisor);
+      }
+      bench_shards_merge();
+      bench_shards_meld();
+
+      // Bulk purge
+      bench_purge_eraseIf();
+      bench_purge_drain();
+
+      // Batched drain, the last a quarter of the heap in one batch
+      for (size_t num : { size_t(64), size_t(1024), size_t(4096), numItems / 64, numItems / 16 })
+      {
+         bench_popN(num);
+         bench_popValueLoop(num);
+         bench_popLoop(num);
+      }
+
+      // Arity
+      for (size_t num = 1000; num <= numItems; num *= 10)
+      {
+         bench_arity<2>(num);
+         bench_arity<4>(num);
+         bench_arity<8>(num);
+      }
+
+      // Branchless child search
+      for (size_t num = numItems / 100; num <= numItems; num *= 10)
+      {
+         std::vector<int> keys = randomKeys(num);
+         bench_branchless<BoxedInt, 2>(keys, "scalar");
+         bench_branchless<int,      2>(keys, "branchless");
+         bench_branchless<BoxedInt, 4>(keys, "scalar");
+         bench_branchless<int,      4>(keys, "branchless");
+      }
+
+      // Prefetch on huge heaps. The biggest, numItems * 500 ints, takes
+      // 2 GB with the default numItems, so it only runs with BENCHMARK_HUGE
+      for (size_t multiple : { 10, 100 })
+      {
+         bench_prefetch<2>(numItems * multiple);
+         bench_prefetch<4>(numItems * multiple);
+         bench_prefetch<2, custom::layout_blocked<64> >(numItems * multiple, "blocked 64");
+      }
+#ifdef BENCHMARK_HUGE
+      bench_prefetch<2>(numItems * 500);
+      bench_prefetch<4>(numItems * 500);
+      bench_prefetch<2, custom::layout_blocked<64> >(numItems * 500, "blocked 64");
+#endif // BENCHMARK_HUGE
+
+      // Memory layout on huge heaps
+      for (size_t multiple : { 10, 100 })
+      {
+         bench_layout<custom::layout_flat         >(numItems * multiple, "flat");
+         bench_layout<custom::layout_blocked<64>  >(numItems * multiple, "blocked 64");
+         bench_layout<custom::layout_blocked<4096> >(numItems * multiple, "blocked 4096");
+      }
+
+      // Vector child search, only compiled in for SSE4.2 or AVX2
+      {
+         std::vector<int> keys = randomKeys(numItems * 10);
+         std::cout << "\tvector instruction set: " << simdName() << "\n";
+         bench_wide<int, std::less<int>,    2>(keys);
+         bench_wide<int, OpaqueLess<int>,   8>(keys);
+         bench_wide<int, std::less<int>,    8>(keys);
+         bench_wide<int, OpaqueLess<int>,  16>(keys);
+         bench_wide<int, std::less<int>,   16>(keys);
+         bench_wide<double, std::less<double>,  2>(keys);
+         bench_wide<double, OpaqueLess<double>, 8>(keys);
+         bench_wide<double, std::less<double>,  8>(keys);
+      }
+
+      // Cancelled timers
+      bench_timers_skip();
+      bench_timers_lazy();
+
+      // Bounded queue
+      bench_bounded_minmax();
+      bench_bounded_twoHeaps();
+
+      // Shortest paths
+      {
+         Graph graph = randomGraph(numItems / 4, 8);
+         bench_dijkstra_duplicates(graph);
+         bench_dijkstra_indexed(graph);
+         bench_dijkstra_pairing(graph);
+         bench_dijkstra_radix(graph);
+      }
+
+      // Shortest paths on a road network sized grid
+      {
+         Graph graph = gridGraph(2000, 2000);
+         bench_dijkstra_duplicates(graph, "road grid, binary heap");
+         bench_dijkstra_radix(graph, "road grid, radix heap");
+      }
+
+      // keep the optimizer from discarding the work
+      std::cout << "checksum: " << checksum << "\n";
+   }
+
+   /***************************************
+    * MIN HEAP
+    ***************************************/
+
+   // a min heap through the Compare template parameter
+   void bench_minHeap_greater()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      double ms = time([&]()
+      {
+         custom::priority_queue <int, std::greater<int>> pq;
+         for (int key : keys)
+            pq.push(key);
+         while (!pq.empty())
+         {
+            checksum += pq.top();
+            pq.pop();
+         }
+      });
+      report("min heap, std::greater", ms);
+   }
+
+   // a min heap the old way: wrap every key with an inverted operator<
+   void bench_minHeap_wrapper()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      double ms = time([&]()
+      {
+         custom::priority_queue <Inverted> pq;
+         for (int key : keys)
+            pq.push(Inverted(key));
+         while (!pq.empty())
+         {
+            checksum += pq.top().key;
+            pq.pop();
+         }
+      });
+      report("min heap, inverted wrapper", ms);
+   }
+
+   /***************************************
+    * STABLE
+    * Schedule jobs of 16 priorities, so most of them
+    * tie, and run them oldest first within a priority
+    ***************************************/
+
+   // the wrapper clients write by hand: a sequence number and operator<
+   void bench_stable_wrapper(size_t num)
+   {
+      std::vector<int> keys = randomKeys(num);
+      double ms = time([&]()
+      {
+         custom::priority_queue <Sequenced> pq;
+         uint64_t sequence = 0;
+         for (int key : keys)
+            pq.push(Sequenced{ Job{ key & 15, key }, sequence++ });
+         while (!pq.empty())
+         {
+            checksum += pq.top().job.id;
+            pq.pop();
+         }
+      });
+      report("stable " + std::to_string(num) + ", hand-written wrapper", ms, num);
+   }
+
+   // the same jobs in a stable_priority_queue
+   template <class Compare>
+   void bench_stable(size_t num, const std::string & name)
+   {
+      std::vector<int> keys = randomKeys(num);
+      double ms = time([&]()
+      {
+         custom::stable_priority_queue <Job, Compare> pq;
+         for (int key : keys)
+            pq.push(Job{ key & 15, key });
+         while (!pq.empty())
+         {
+            checksum += pq.top().id;
+            pq.pop();
+         }
+      });
+      report("stable " + std::to_string(num) + ", " + name, ms, num);
+   }
+
+   /***************************************
+    * PROJECTION
+    * Push then drain strings ordered by a score
+    * computed from all of their characters
+    ***************************************/
+
+   // compare_by: the score is computed twice per comparison
+   void bench_projection_compareBy()
+   {
+      custom::vector<std::string> strings = randomStrings(numItems / 4);
+      CountingScore::numCalls = 0;
+      double ms = time([&]()
+      {
+         custom::priority_queue <std::string, custom::compare_by<CountingScore> > pq;
+         for (size_t i = 0; i < strings.size(); i++)
+            pq.push(strings[i]);
+         while (!pq.empty())
+         {
+            checksum += pq.top().size();
+            pq.pop();
+         }
+      });
+      report("score, compare_by", ms, strings.size());
+      std::cout << "\t\tscores per item: "
+                << double(CountingScore::numCalls) / double(strings.size()) << "\n";
+   }
+
+   // keyed_priority_queue: the score is computed once per item
+   void bench_projection_keyed()
+   {
+      custom::vector<std::string> strings = randomStrings(numItems / 4);
+      CountingScore::numCalls = 0;
+      double ms = time([&]()
+      {
+         custom::keyed_priority_queue <std::string, CountingScore> pq;
+         for (size_t i = 0; i < strings.size(); i++)
+            pq.push(strings[i]);
+         while (!pq.empty())
+         {
+            checksum += pq.top().size();
+            pq.pop();
+         }
+      });
+      report("score, keyed", ms, strings.size());
+      std::cout << "\t\tscores per item: "
+                << double(CountingScore::numCalls) / double(strings.size()) << "\n";
+   }
+
+   /***************************************
+    * PAYLOAD
+    * Push then drain numItems/8 items, each an 8-byte
+    * key and a payload of Size bytes, stored inline
+    * and split apart from the heap
+    ***************************************/
+   template <size_t Size>
+   void bench_payload()
+   {
+      std::vector<int> keys = randomKeys(numItems / 8);
+      double msInline = time([&]()
+      {
+         custom::priority_queue <Item<Size> > pq;
+         for (int key : keys)
+         {
+            Item<Size> item;
+            item.key = uint64_t(key);
+            item.payload.bytes[0] = char(key);
+            pq.push(std::move(item));
+         }
+         while (!pq.empty())
+         {
+            checksum += pq.top().payload.bytes[0];
+            pq.pop();
+         }
+      });
+      double msSplit = time([&]()
+      {
+         custom::split_priority_queue <uint64_t, Payload<Size> > pq;
+         for (int key : keys)
+         {
+            Payload<Size> payload;
+            payload.bytes[0] = char(key);
+            pq.push(uint64_t(key), std::move(payload));
+         }
+         while (!pq.empty())
+         {
+            checksum += pq.top().bytes[0];
+            pq.pop();
+         }
+      });
+      std::string name = std::to_string(Size) + "-byte payload, ";
+      report(name + "inline", msInline, keys.size());
+      report(name + "split",  msSplit,  keys.size());
+   }
+
+   /***************************************
+    * BULK LOAD
+    ***************************************/
+
+   // build the heap in O(n) by moving a filled vector in
+   void bench_build_heapify()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      double ms = time([&]()
+      {
+         custom::vector <int> v;
+         v.reserve(keys.size());
+         for (int key : keys)
+            v.push_back(key);
+         custom::priority_queue <int> pq(std::move(v));
+         checksum += pq.top();
+      });
+      report("build, heapify", ms);
+   }
+
+   // build the heap one push at a time
+   void bench_build_push()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      double ms = time([&]()
+      {
+         custom::priority_queue <int> pq;
+         for (int key : keys)
+            pq.push(key);
+         checksum += pq.top();
+      });
+      report("build, n pushes", ms);
+   }
+
+   /***************************************
+    * ARITY
+    ***************************************/
+
+   // push then pop num items on a heap with Arity children per node
+   template <size_t Arity>
+   void bench_arity(size_t num)
+   {
+      std::vector<int> keys = randomKeys(num);
+      custom::priority_queue <int, std::less<int>, Arity> pq;
+      double msPush = time([&]()
+      {
+         for (int key : keys)
+            pq.push(key);
+      });
+      double msPop = time([&]()
+      {
+         while (!pq.empty())
+         {
+            checksum += pq.top();
+            pq.pop();
+         }
+      });
+      std::string name = std::to_string(Arity) + "-ary, " + std::to_string(num) + " items";
+      report(name + " push", msPush, num);
+      report(name + " pop",  msPop,  num);
+   }
+
+   /***************************************
+    * BRANCHLESS
+    * Pop every key off a heap of random keys, counting
+    * mispredicted branches where the OS allows it.
+    * BoxedInt is an int that is not trivially copyable,
+    * so its heap takes the scalar child search.
+    ***************************************/
+   template <class T, size_t Arity>
+   void bench_branchless(const std::vector<int> & keys, const char * search)
+   {
+      custom::priority_queue <T, std::less<T>, Arity> pq(keys.begin(), keys.end());
+      double ms = 0.0;
+      long long numMisses = branchMisses([&]()
+      {
+         ms = time([&]()
+         {
+            while (!pq.empty())
+            {
+               checksum += int(pq.top());
+               pq.pop();
+            }
+         });
+      });
+      std::string name = std::to_string(Arity) + "-ary " + search + ", " +
+                         std::to_string(keys.size()) + " pops";
+      report(name, ms, keys.size());
+      if (numMisses >= 0)
+         std::cout << "\t\tbranch misses: " << std::setprecision(2)
+                   << double(numMisses) / double(keys.size()) << " per pop\n";
+   }
+
+   /***************************************
+    * PREFETCH
+    * Pop numItems keys off a heap of num random keys,
+    * far bigger than the cache. Build once with
+    * -DPQUEUE_PREFETCH_LEVELS=0 to compare.
+    * The keys go straight into the heap's vector:
+    * at 500M there is no room for a second copy.
+    ***************************************/
+   template <size_t Arity, class Layout = custom::layout_flat>
+   void bench_prefetch(size_t num, const char * layout = "flat")
+   {
+      std::mt19937 generator(42);
+      custom::vector<int> keys;
+      keys.reserve(num);
+      for (size_t i = 0; i < num; i++)
+         keys.push_back(int(generator() >> 1));
+      custom::priority_queue <int, std::less<int>, Arity, custom::pop_top_down, Layout> pq(std::move(keys));
+
+      double ms = time([&]()
+      {
+         for (size_t i = 0; i < numItems; i++)
+         {
+            checksum += pq.top();
+            pq.pop();
+         }
+      });
+      std::string name = std::to_string(Arity) + "-ary " + layout + ", " + std::to_string(num / 1000000) +
+                         "M items, prefetch " + std::to_string(PQUEUE_PREFETCH_LEVELS);
+      report(name, ms, numItems);
+   }
+
+   /***************************************
+    * LAYOUT
+    * Pop numItems keys off a binary heap of num random
+    * keys, then push as many, with the nodes stored
+    * level by level or a subtree per block
+    ***************************************/
+   template <class Layout>
+   void bench_layout(size_t num, const char * layout)
+   {
+      std::mt19937 generator(42);
+      custom::vector<int> keys;
+      keys.reserve(num);
+      for (size_t i = 0; i < num; i++)
+         keys.push_back(int(generator() >> 1));
+      custom::priority_queue <int, std::less<int>, 2, custom::pop_top_down, Layout> pq(std::move(keys));
+
+      double msPop = time([&]()
+      {
+         for (size_t i = 0; i < numItems; i++)
+         {
+            checksum += pq.top();
+            pq.pop();
+         }
+      });
+      double msPush = time([&]()
+      {
+         for (size_t i = 0; i < numItems; i++)
+            pq.push(int(generator() >> 1));
+      });
+      std::string name = std::string(layout) + ", " + std::to_string(num / 1000000) + "M items";
+      report(name + " pop",  msPop,  numItems);
+      report(name + " push", msPush, numItems);
+   }
+
+   /***************************************
+    * WIDE
+    * Pop every key off a heap built from keys. With
+    * std::less, 8 or 16 children are searched with
+    * vector compares when compiled for SSE4.2 or AVX2,
+    * and with the branchless search otherwise;
+    * OpaqueLess keeps the same heap on the branchless
+    * search. Each row names the search the heap was
+    * compiled with.
+    ***************************************/
+   template <class T, class Compare, size_t Arity>
+   void bench_wide(const std::vector<int> & keys)
+   {
+      typedef custom::priority_queue <T, Compare, Arity> PQ;
+      const char * search = searchName<PQ>();
+      PQ pq(keys.begin(), keys.end());
+      double ms = time([&]()
+      {
+         while (!pq.empty())
+         {
+            checksum += size_t(pq.top());
+            pq.pop();
+         }
+      });
+      std::string name = std::string(sizeof(T) == 4 ? "int32 " : "double ") +
+                         std::to_string(Arity) + "-ary " + search + ", " +
+                         std::to_string(keys.size()) + " pops";
+      report(name, ms, keys.size());
+   }
+
+   /***************************************
+    * TIMERS
+    * Run numItems ticks of a timer service, soonest
+    * deadline on top. Each tick schedules one timer:
+    * three of every five are short and fire, two are
+    * long timeouts that are cancelled five ticks later.
+    * Then every timer that is due fires.
+    ***************************************/
+
+   typedef std::pair<uint64_t, uint32_t> Timer;  // deadline, id
+
+   // deadline of the timer scheduled at this tick
+   static uint64_t deadline(uint32_t id, int key)
+   {
+      return id % 5 < 2 ? uint64_t(id) + 65536 + (key & 0xffff) : uint64_t(id) + (key & 0xfff);
+   }
+
+   // what clients do today: flag the cancelled ids and skip
+   // them when they come off the top
+   void bench_timers_skip()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      size_t sizeMax = 0;
+      double ms = time([&]()
+      {
+         std::vector<char> isCancelled(keys.size(), false);
+         custom::priority_queue <Timer, std::greater<Timer> > pq;
+         for (uint32_t id = 0; id < keys.size(); id++)
+         {
+            pq.push(Timer(deadline(id, keys[id]), id));
+            if (id % 5 < 2 && id >= 5)
+               isCancelled[id - 5] = true;
+            while (!pq.empty() && pq.top().first <= id)
+            {
+               if (!isCancelled[pq.top().second])
+                  checksum += pq.top().first;
+               pq.pop();
+            }
+            sizeMax = pq.size() > sizeMax ? pq.size() : sizeMax;
+         }
+      });
+      report("timers, skip cancelled", ms, keys.size());
+      std::cout << "\t\tlargest heap: " << sizeMax << "\n";
+   }
+
+   // the same timers in a lazy_priority_queue
+   void bench_timers_lazy()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      size_t sizeMax = 0;
+      double ms = time([&]()
+      {
+         std::vector<uint64_t> handles(keys.size());
+         custom::lazy_priority_queue <Timer, std::greater<Timer> > pq;
+         for (uint32_t id = 0; id < keys.size(); id++)
+         {
+            handles[id] = pq.push(Timer(deadline(id, keys[id]), id));
+            if (id % 5 < 2 && id >= 5)
+               pq.cancel(handles[id - 5]);
+            while (!pq.empty() && pq.top().first <= id)
+            {
+               checksum += pq.top().first;
+               pq.pop();
+            }
+            sizeMax = pq.heap.size() > sizeMax ? pq.heap.size() : sizeMax;
+         }
+      });
+      report("timers, lazy cancel", ms, keys.size());
+      std::cout << "\t\tlargest heap: " << sizeMax << "\n";
+   }
+
+   /***************************************
+    * BOUNDED QUEUE
+    * Admit numItems * 10 requests into a queue that
+    * holds at most 1000. Every fourth request the
+    * most urgent one is dispatched, and when the
+    * queue overflows the least urgent one is evicted.
+    ***************************************/
+
+   typedef std::pair<int, uint32_t> Request;  // urgency, id
+
+   // one min-max heap holds every request once
+   void bench_bounded_minmax()
+   {
+      std::vector<int> keys = randomKeys(numItems * 10);
+      size_t sizeMax = 0;
+      double ms = time([&]()
+      {
+         custom::minmax_heap <Request> pq;
+         for (uint32_t id = 0; id < keys.size(); id++)
+         {
+            pq.push(Request(keys[id], id));
+            if (id % 4 == 3)
+            {
+               checksum += pq.top_max().first;
+               pq.pop_max();
+            }
+            if (pq.size() > numTopK)
+               pq.pop_min();
+            sizeMax = pq.container.size() > sizeMax ? pq.container.size() : sizeMax;
+         }
+         checksum += pq.top_min().first;
+      });
+      report("bounded, minmax_heap", ms, keys.size());
+      std::cout << "\t\tlargest storage: " << sizeMax << " items\n";
+   }
+
+   // what clients do today: a max heap and a min heap of the same
+   // requests, each cancelling in the other what it pops
+   void bench_bounded_twoHeaps()
+   {
+      std::vector<int> keys = randomKeys(numItems * 10);
+      size_t sizeMax = 0;
+      double ms = time([&]()
+      {
+         std::vector<uint64_t> handlesMax(keys.size());
+         std::vector<uint64_t> handlesMin(keys.size());
+         custom::lazy_priority_queue <Request> pqMax;
+         custom::lazy_priority_queue <Request, std::greater<Request> > pqMin;
+         for (uint32_t id = 0; id < keys.size(); id++)
+         {
+            handlesMax[id] = pqMax.push(Request(keys[id], id));
+            handlesMin[id] = pqMin.push(Request(keys[id], id));
+            if (id % 4 == 3)
+            {
+               Request request = pqMax.pop_value();
+               pqMin.cancel(handlesMin[request.second]);
+               checksum += request.first;
+            }
+            if (pqMin.size() > numTopK)
+               pqMax.cancel(handlesMax[pqMin.pop_value().second]);
+            size_t size = pqMax.heap.size() + pqMin.heap.size();
+            sizeMax = size > sizeMax ? size : sizeMax;
+         }
+         checksum += pqMin.top().first;
+      });
+      report("bounded, two lazy heaps", ms, keys.size());
+      std::cout << "\t\tlargest storage: " << sizeMax << " items\n";
+   }
+
+   /***************************************
+    * DIJKSTRA
+    * Single-source shortest paths on a random
+    * graph, the smallest distance on top
+    ***************************************/
+
+   // a directed graph in compressed rows: the edges
+   // out of node n are first[n] .. first[n+1]-1
+   struct Graph
+   {
+      std::vector<uint32_t> first;
+      std::vector<uint32_t> to;
+      std::vector<uint32_t> weight;
+   };
+
+   typedef std::pair<uint64_t, uint32_t> Path;  // distance, node
+
+   // push a node again whenever its distance drops, and skip the
+   // stale entries when they come off the top
+   void bench_dijkstra_duplicates(const Graph & graph,
+                                  const char * name = "dijkstra, duplicate pushes")
+   {
+      size_t numNodes = graph.first.size() - 1;
+      size_t sizeMax = 0;
+      size_t numPops = 0;
+      double ms = time([&]()
+      {
+         std::vector<uint64_t> distances(numNodes, UINT64_MAX);
+         custom::priority_queue <Path, std::greater<Path> > pq;
+         distances[0] = 0;
+         pq.push(Path(0, 0));
+         while (!pq.empty())
+         {
+            Path path = pq.pop_value();
+            numPops++;
+            if (path.first > distances[path.second])
+               continue;
+            for (uint32_t i = graph.first[path.second]; i < graph.first[path.second + 1]; i++)
+            {
+               uint64_t distance = path.first + graph.weight[i];
+               if (distance < distances[graph.to[i]])
+               {
+                  distances[graph.to[i]] = distance;
+                  pq.push(Path(distance, graph.to[i]));
+                  sizeMax = pq.size() > sizeMax ? pq.size() : sizeMax;
+               }
+            }
+         }
+         checksum += sumReachable(distances);
+      });
+      report(name, ms, numNodes);
+      std::cout << "\t\tlargest heap: " << sizeMax << ", pops: " << numPops << "\n";
+   }
+
+   // one entry per node, its distance lowered in place
+   void bench_dijkstra_indexed(const Graph & graph)
+   {
+      size_t numNodes = graph.first.size() - 1;
+      size_t sizeMax = 0;
+      size_t numPops = 0;
+      double ms = time([&]()
+      {
+         std::vector<uint64_t> distances(numNodes, UINT64_MAX);
+         std::vector<uint64_t> handles(numNodes);
+         custom::indexed_priority_queue <Path, std::greater<Path> > pq;
+         distances[0] = 0;
+         handles[0] = pq.push(Path(0, 0));
+         while (!pq.empty())
+         {
+            Path path = pq.pop_value();
+            numPops++;
+            for (uint32_t i = graph.first[path.second]; i < graph.first[path.second + 1]; i++)
+            {
+               uint32_t to = graph.to[i];
+               uint64_t distance = path.first + graph.weight[i];
+               if (distance < distances[to])
+               {
+                  if (distances[to] == UINT64_MAX)
+                     handles[to] = pq.push(Path(distance, to));
+                  else
+                     pq.update(handles[to], Path(distance, to));
+                  distances[to] = distance;
+                  sizeMax = pq.size() > sizeMax ? pq.size() : sizeMax;
+               }
+            }
+         }
+         checksum += sumReachable(distances);
+      });
+      report("dijkstra, indexed update", ms, numNodes);
+      std::cout << "\t\tlargest heap: " << sizeMax << ", pops: " << numPops << "\n";
+   }
+
+   // one node per node of the graph, raised with decrease_key
+   void bench_dijkstra_pairing(const Graph & graph)
+   {
+      size_t numNodes = graph.first.size() - 1;
+      size_t sizeMax = 0;
+      size_t numPops = 0;
+      double ms = time([&]()
+      {
+         typedef custom::pairing_heap <Path, std::greater<Path> > heap;
+         std::vector<uint64_t> distances(numNodes, UINT64_MAX);
+         std::vector<heap::handle> handles(numNodes);
+         heap pq;
+         distances[0] = 0;
+         handles[0] = pq.push(Path(0, 0));
+         while (!pq.empty())
+         {
+            Path path = pq.pop_value();
+            numPops++;
+            for (uint32_t i = graph.first[path.second]; i < graph.first[path.second + 1]; i++)
+            {
+               uint32_t to = graph.to[i];
+               uint64_t distance = path.first + graph.weight[i];
+               if (distance < distances[to])
+               {
+                  if (distances[to] == UINT64_MAX)
+                     handles[to] = pq.push(Path(distance, to));
+                  else
+                     pq.decrease_key(handles[to], Path(distance, to));
+                  distances[to] = distance;
+                  sizeMax = pq.size() > sizeMax ? pq.size() : sizeMax;
+               }
+            }
+         }
+         checksum += sumReachable(distances);
+      });
+      report("dijkstra, pairing decrease_key", ms, numNodes);
+      std::cout << "\t\tlargest heap: " << sizeMax << ", pops: " << numPops << "\n";
+   }
+
+   // duplicate pushes again, in a radix heap: the distances popped
+   // never go down, which is all it needs
+   void bench_dijkstra_radix(const Graph & graph, const char * name = "dijkstra, radix heap")
+   {
+      size_t numNodes = graph.first.size() - 1;
+      size_t sizeMax = 0;
+      size_t numPops = 0;
+      double ms = time([&]()
+      {
+         std::vector<uint64_t> distances(numNodes, UINT64_MAX);
+         custom::radix_heap <uint64_t, uint32_t> pq;
+         distances[0] = 0;
+         pq.push(uint64_t(0), 0u);
+         while (!pq.empty())
+         {
+            uint64_t distanceFrom = pq.top_key();
+            uint32_t from = pq.pop_value();
+            numPops++;
+            if (distanceFrom > distances[from])
+               continue;
+            for (uint32_t i = graph.first[from]; i < graph.first[from + 1]; i++)
+            {
+               uint64_t distance = distanceFrom + graph.weight[i];
+               if (distance < distances[graph.to[i]])
+               {
+                  distances[graph.to[i]] = distance;
+                  pq.push(distance, graph.to[i]);
+                  sizeMax = pq.size() > sizeMax ? pq.size() : sizeMax;
+               }
+            }
+         }
+         checksum += sumReachable(distances);
+      });
+      report(name, ms, numNodes);
+      std::cout << "\t\tlargest heap: " << sizeMax << ", pops: " << numPops << "\n";
+   }
+
+   /***************************************
+    * POP STRATEGY
+    ***************************************/
+
+   // drain a heap of strings that share a long prefix, so every
+   // comparison is expensive
+   template <class PopStrategy>
+   void bench_pop_strategy(const char * name)
+   {
+      custom::priority_queue <std::string, CountingLess, 2, PopStrategy> pq(randomStrings(numItems / 4));
+      CountingLess::numCompares = 0;
+      double ms = time([&]()
+      {
+         while (!pq.empty())
+         {
+            checksum += pq.top().size();
+            pq.pop();
+         }
+      });
+      report(name, ms, numItems / 4);
+      std::cout << "\t\tcomparisons per pop: "
+                << double(CountingLess::numCompares) / double(numItems / 4) << "\n";
+   }
+
+   /***************************************
+    * TOP-K STREAM
+    * Keep the 1000 largest keys of a rising stream in a
+    * min heap, so nearly every key is admitted
+    ***************************************/
+
+   // the old way: pop the smallest then push the newcomer
+   void bench_topK_popPush()
+   {
+      std::vector<int> keys = risingKeys(numItems * 10);
+      double ms = time([&]()
+      {
+         custom::priority_queue <int, std::greater<int>> pq;
+         for (int key : keys)
+            if (pq.size() < numTopK)
+               pq.push(key);
+            else if (pq.top() < key)
+            {
+               pq.pop();
+               pq.push(key);
+            }
+         checksum += pq.top();
+      });
+      report("top-1000, pop then push", ms, keys.size());
+   }
+
+   // one percolate down per admitted key
+   void bench_topK_replaceTop()
+   {
+      std::vector<int> keys = risingKeys(numItems * 10);
+      double ms = time([&]()
+      {
+         custom::priority_queue <int, std::greater<int>> pq;
+         for (int key : keys)
+            if (pq.size() < numTopK)
+               pq.push(key);
+            else if (pq.top() < key)
+               pq.replace_top(key);
+         checksum += pq.top();
+      });
+      report("top-1000, replace_top", ms, keys.size());
+   }
+
+   // push_pop does the admission test itself
+   void bench_topK_pushPop()
+   {
+      std::vector<int> keys = risingKeys(numItems * 10);
+      double ms = time([&]()
+      {
+         custom::priority_queue <int, std::greater<int>> pq;
+         for (int key : keys)
+            if (pq.size() < numTopK)
+               pq.push(key);
+            else
+               checksum += pq.push_pop(key);
+         checksum += pq.top();
+      });
+      report("top-1000, push_pop", ms, keys.size());
+   }
+
+   /***************************************
+    * PUSH RANGE
+    ***************************************/
+
+   // tune bulkRatio: repair a batch of size()/divisor appended items
+   // both ways, with random keys and with keys that all rise to the top
+   void bench_pushRange_crossover(size_t divisor)
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      size_t numBatch = numItems / divisor;
+      std::vector<int> batch = randomKeys(numBatch, 7);
+      for (int rising = 0; rising <= 1; rising++)
+      {
+         double msUp = 0.0;
+         double msHeapify = 0.0;
+         for (int how = 0; how <= 1; how++)
+         {
+            custom::priority_queue <int> pq;
+            pq.push_range(keys.begin(), keys.end());
+            size_t numOld = pq.size();
+            pq.reserveAppend(numBatch);
+            for (int key : batch)
+               pq.container.push_back(rising ? key | 0x40000000 : key);
+            double ms = time([&]()
+            {
+               if (how)
+                  pq.heapifyAppended(numOld);
+               else
+                  for (size_t indexHeap = numOld + 1; indexHeap <= pq.size(); indexHeap++)
+                     pq.percolateUp(indexHeap);
+            });
+            (how ? msHeapify : msUp) = ms;
+            checksum += pq.top();
+         }
+         std::string name = "batch of 1/" + std::to_string(divisor) +
+                            (rising ? ", rising" : ", random");
+         report(name + " percolate up", msUp,      numBatch);
+         report(name + " heapify",      msHeapify, numBatch);
+      }
+   }
+
+   // stream batches of 10K..1M items through push_range
+   void bench_pushRange_batches()
+   {
+      std::vector<int> keys = randomKeys(numItems * 4);
+      double ms = time([&]()
+      {
+         custom::priority_queue <int> pq;
+         for (size_t begin = 0, num = 10000; begin < keys.size(); begin += num, num *= 2)
+         {
+            size_t end = begin + num < keys.size() ? begin + num : keys.size();
+            pq.push_range(keys.begin() + begin, keys.begin() + end);
+         }
+         checksum += pq.top();
+      });
+      report("batches, push_range", ms, keys.size());
+   }
+
+   // the same batches one push at a time
+   void bench_push_batches()
+   {
+      std::vector<int> keys = randomKeys(numItems * 4);
+      double ms = time([&]()
+      {
+         custom::priority_queue <int> pq;
+         for (int key : keys)
+            pq.push(key);
+         checksum += pq.top();
+      });
+      report("batches, push", ms, keys.size());
+   }
+
+   /***************************************
+    * MERGE
+    * Combine a heap of numItems with one of
+    * numItems/divisor
+    ***************************************/
+
+   // merge, in either direction
+   void bench_merge(size_t divisor, bool isBigIntoSmall)
+   {
+      std::vector<int> keysBig = randomKeys(numItems);
+      custom::priority_queue <int> pqBig(keysBig.begin(), keysBig.end());
+      std::vector<int> keys = randomKeys(numItems / divisor, 7);
+      custom::priority_queue <int> pqSmall(keys.begin(), keys.end());
+      double ms = time([&]()
+      {
+         if (isBigIntoSmall)
+         {
+            pqSmall.merge(std::move(pqBig));
+            checksum += pqSmall.top();
+         }
+         else
+         {
+            pqBig.merge(std::move(pqSmall));
+            checksum += pqBig.top();
+         }
+      });
+      report("merge 1/" + std::to_string(divisor) +
+             (isBigIntoSmall ? ", big into small" : ", small into big"), ms, keys.size());
+   }
+
+   // pop the small heap and push each item into the big one
+   void bench_merge_popPush(size_t divisor)
+   {
+      std::vector<int> keysBig = randomKeys(numItems);
+      custom::priority_queue <int> pqBig(keysBig.begin(), keysBig.end());
+      std::vector<int> keys = randomKeys(numItems / divisor, 7);
+      custom::priority_queue <int> pqSmall(keys.begin(), keys.end());
+      double ms = time([&]()
+      {
+         while (!pqSmall.empty())
+            pqBig.push(pqSmall.pop_value());
+         checksum += pqBig.top();
+      });
+      report("merge 1/" + std::to_string(divisor) + ", pop and push", ms, keys.size());
+   }
+
+   // the same merge of two pairing heaps, then one pop to pay for it
+   void bench_meld_pairing(size_t divisor)
+   {
+      std::vector<int> keysBig = randomKeys(numItems);
+      custom::pairing_heap <int> pqBig;
+      for (int key : keysBig)
+         pqBig.push(key);
+      std::vector<int> keys = randomKeys(numItems / divisor, 7);
+      custom::pairing_heap <int> pqSmall;
+      for (int key : keys)
+         pqSmall.push(key);
+      double ms = time([&]()
+      {
+         pqBig.meld(std::move(pqSmall));
+         checksum += pqBig.pop_value();
+      });
+      report("merge 1/" + std::to_string(divisor) + ", pairing meld and pop", ms, keys.size());
+   }
+
+   /***************************************
+    * SHARDS
+    * Fill 1024 shards of numItems / 1024 keys, merge
+    * them in pairs until one is left, and take the
+    * top 1000 from it
+    ***************************************/
+
+   static const size_t numShards = 1024;
+
+   // priority_queue::merge, each merge moving the smaller heap
+   void bench_shards_merge()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      double ms = time([&]()
+      {
+         std::vector<custom::priority_queue <int> > shards(numShards);
+         for (size_t i = 0; i < keys.size(); i++)
+            shards[i % numShards].push(keys[i]);
+         for (size_t step = 1; step < numShards; step *= 2)
+            for (size_t i = 0; i + step < numShards; i += step * 2)
+               shards[i].merge(std::move(shards[i + step]));
+         for (size_t i = 0; i < numTopK; i++)
+            checksum += shards[0].pop_value();
+      });
+      report("shards, merge", ms, keys.size());
+   }
+
+   // pairing_heap::meld, each meld one link
+   void bench_shards_meld()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      double ms = time([&]()
+      {
+         std::vector<custom::pairing_heap <int> > shards(numShards);
+         for (size_t i = 0; i < keys.size(); i++)
+            shards[i % numShards].push(keys[i]);
+         for (size_t step = 1; step < numShards; step *= 2)
+            for (size_t i = 0; i + step < numShards; i += step * 2)
+               shards[i].meld(std::move(shards[i + step]));
+         for (size_t i = 0; i < numTopK; i++)
+            checksum += shards[0].pop_value();
+      });
+      report("shards, pairing meld", ms, keys.size());
+   }
+
+   /***************************************
+    * PURGE
+    * Evict one tenant of 64 from a heap of numItems
+    * items: the tenant is the low six bits
+    ***************************************/
+
+   // erase_if: one pass and a linear rebuild
+   void bench_purge_eraseIf()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      custom::priority_queue <int> pq(keys.begin(), keys.end());
+      double ms = time([&]()
+      {
+         checksum += pq.erase_if([](int key) { return (key & 63) == 17; });
+      });
+      report("purge, erase_if", ms, keys.size());
+   }
+
+   // drain the heap and push back every item of the other tenants
+   void bench_purge_drain()
+   {
+      std::vector<int> keys = randomKeys(numItems);
+      custom::priority_queue <int> pq(keys.begin(), keys.end());
+      double ms = time([&]()
+      {
+         custom::priority_queue <int> pqKept;
+         while (!pq.empty())
+         {
+            int key = pq.pop_value();
+            if ((key & 63) != 17)
+               pqKept.push(key);
+         }
+         swap(pq, pqKept);
+         checksum += pq.size();
+      });
+      report("purge, drain and push", ms, keys.size());
+   }
+
+   /***************************************
+    * POP N
+    * Drain a quarter of a heap of strings in batches of num
+    ***************************************/
+
+   // one pop_n per batch
+   void bench_popN(size_t num)
+   {
+      custom::priority_queue <std::string> pq(randomStrings(numItems / 4));
+      std::vector<std::string> batch(num);
+      double ms = time([&]()
+      {
+         for (size_t numLeft = pq.size() / 4; numLeft >= num; numLeft -= num)
+         {
+            pq.pop_n(num, batch.begin());
+            checksum += batch[0].size();
+         }
+      });
+      report("drain by " + std::to_string(num) + ", pop_n", ms, numItems / 16);
+   }
+
+   // move out with pop_value, once per item
+   void bench_popValueLoop(size_t num)
+   {
+      custom::priority_queue <std::string> pq(randomStrings(numItems / 4));
+      std::vector<std::string> batch(num);
+      double ms = time([&]()
+      {
+         for (size_t numLeft = pq.size() / 4; numLeft >= num; numLeft -= num)
+         {
+            for (size_t i = 0; i < num; i++)
+               batch[i] = pq.pop_value();
+            checksum += batch[0].size();
+         }
+      });
+      report("drain by " + std::to_string(num) + ", pop_value", ms, numItems / 16);
+   }
+
+   // copy out of top then pop, once per item
+   void bench_popLoop(size_t num)
+   {
+      custom::priority_queue <std::string> pq(randomStrings(numItems / 4));
+      std::vector<std::string> batch(num);
+      double ms = time([&]()
+      {
+         for (size_t numLeft = pq.size() / 4; numLeft >= num; numLeft -= num)
+         {
+            for (size_t i = 0; i < num; i++)
+            {
+               batch[i] = pq.top();
+               pq.pop();
+            }
+            checksum += batch[0].size();
+         }
+      });
+      report("drain by " + std::to_string(num) + ", top and pop", ms, numItems / 16);
+   }
+
+private:
+
+   /***************************************************
+    * INVERTED
+    * The wrapper clients used before Compare existed
+    ***************************************************/
+   struct Inverted
+   {
+      Inverted(int key = 0) : key(key) {}
+      bool operator<(const Inverted & rhs) const { return rhs.key < key; }
+      int key;
+   };
+
+   /***************************************************
+    * BOXED INT
+    * An int with a copy constructor of its own, so
+    * that it is not trivially copyable
+    ***************************************************/
+   struct BoxedInt
+   {
+      BoxedInt(int key = 0) : key(key) {}
+      BoxedInt(const BoxedInt & rhs) : key(rhs.key) {}
+      BoxedInt & operator=(const BoxedInt & rhs) = default;
+      bool operator<(const BoxedInt & rhs) const { return key < rhs.key; }
+      explicit operator int() const { return key; }
+      int key;
+   };
+
+   /***************************************************
+    * OPAQUE LESS
+    * std::less by another name, which the vector child
+    * search does not recognize
+    ***************************************************/
+   template <class T>
+   struct OpaqueLess
+   {
+      bool operator()(const T & lhs, const T & rhs) const { return lhs < rhs; }
+   };
+
+   /***************************************************
+    * JOB
+    * What a scheduler queues: a small priority and an id
+    ***************************************************/
+   struct Job
+   {
+      int priority;
+      int id;
+   };
+
+   struct JobPriority
+   {
+      int operator()(const Job & job) const { return job.priority; }
+   };
+
+   struct JobLess
+   {
+      bool operator()(const Job & lhs, const Job & rhs) const { return lhs.priority < rhs.priority; }
+   };
+
+   // a job with the sequence number a client stamps on it by hand
+   struct Sequenced
+   {
+      bool operator<(const Sequenced & rhs) const
+      {
+         return job.priority < rhs.job.priority ||
+               (job.priority == rhs.job.priority && sequence > rhs.sequence);
+      }
+      Job job;
+      uint64_t sequence;
+   };
+
+   /***************************************************
+    * PAYLOAD and ITEM
+    * Size bytes of data, alone and behind a key
+    ***************************************************/
+   template <size_t Size>
+   struct Payload
+   {
+      char bytes[Size];
+   };
+
+   template <size_t Size>
+   struct Item
+   {
+      bool operator<(const Item & rhs) const { return key < rhs.key; }
+      uint64_t key;
+      Payload<Size> payload;
+   };
+
+   /***************************************************
+    * COUNTING LESS
+    * std::less on strings, counting every call
+    ***************************************************/
+   struct CountingLess
+   {
+      bool operator()(const std::string & lhs, const std::string & rhs) const
+      {
+         numCompares++;
+         return lhs < rhs;
+      }
+      static inline long long numCompares = 0;
+   };
+
+   /***************************************************
+    * COUNTING SCORE
+    * A key derived from every character of a string,
+    * counting every call
+    ***************************************************/
+   struct CountingScore
+   {
+      unsigned int operator()(const std::string & s) const
+      {
+         numCalls++;
+         unsigned int score = 0;
+         for (char c : s)
+            score = score * 31 + (unsigned char)c;
+         return score;
+      }
+      static inline long long numCalls = 0;
+   };
+
+   /***************************************************
+    * RANDOM KEYS
+    * The same pseudo-random keys for every run
+    ***************************************************/
+   std::vector<int> randomKeys(size_t num, unsigned int seed = 42)
+   {
+      std::mt19937 generator(seed);
+      std::vector<int> keys(num);
+      for (auto & key : keys)
+         key = int(generator() >> 1);
+      return keys;
+   }
+
+   /***************************************************
+    * RANDOM GRAPH
+    * numNodes nodes, each with degree edges to random
+    * nodes, weighted 1 to 1000
+    ***************************************************/
+   Graph randomGraph(size_t numNodes, size_t degree, unsigned int seed = 42)
+   {
+      std::mt19937 generator(seed);
+      Graph graph;
+      graph.first.reserve(numNodes + 1);
+      graph.to.reserve(numNodes * degree);
+      graph.weight.reserve(numNodes * degree);
+      for (size_t node = 0; node < numNodes; node++)
+      {
+         graph.first.push_back(uint32_t(graph.to.size()));
+         for (size_t i = 0; i < degree; i++)
+         {
+            graph.to.push_back(uint32_t(generator() % numNodes));
+            graph.weight.push_back(uint32_t(generator() % 1000 + 1));
+         }
+      }
+      graph.first.push_back(uint32_t(graph.to.size()));
+      return graph;
+   }
+
+   /***************************************************
+    * GRID GRAPH
+    * A width by height grid, like a road network: each
+    * node has a road to each of its four neighbors, and
+    * every road is weighted 1 to 1000 each way
+    ***************************************************/
+   Graph gridGraph(size_t width, size_t height, unsigned int seed = 42)
+   {
+      std::mt19937 generator(seed);
+      Graph graph;
+      graph.first.reserve(width * height + 1);
+      graph.to.reserve(width * height * 4);
+      graph.weight.reserve(width * height * 4);
+      for (size_t y = 0; y < height; y++)
+         for (size_t x = 0; x < width; x++)
+         {
+            graph.first.push_back(uint32_t(graph.to.size()));
+            size_t node = y * width + x;
+            if (x > 0)          graph.to.push_back(uint32_t(node - 1));
+            if (x + 1 < width)  graph.to.push_back(uint32_t(node + 1));
+            if (y > 0)          graph.to.push_back(uint32_t(node - width));
+            if (y + 1 < height) graph.to.push_back(uint32_t(node + width));
+            while (graph.weight.size() < graph.to.size())
+               graph.weight.push_back(uint32_t(generator() % 1000 + 1));
+         }
+      graph.first.push_back(uint32_t(graph.to.size()));
+      return graph;
+   }
+
+   /***************************************************
+    * SUM REACHABLE
+    * Add up the distances of the nodes that were reached
+    ***************************************************/
+   uint64_t sumReachable(const std::vector<uint64_t> & distances)
+   {
+      uint64_t sum = 0;
+      for (uint64_t distance : distances)
+         if (distance != UINT64_MAX)
+            sum += distance;
+      return sum;
+   }
+
+   /***************************************************
+    * RANDOM STRINGS
+    * Keys that share a long prefix, so every comparison
+    * is expensive and none fit the small-string buffer
+    ***************************************************/
+   custom::vector<std::string> randomStrings(size_t num, unsigned int seed = 42)
+   {
+      std::vector<int> keys = randomKeys(num, seed);
+      custom::vector<std::string> strings;
+      strings.reserve(num);
+      for (int key : keys)
+         strings.push_back("tenant/region/queue/" + std::to_string(key));
+      return strings;
+   }
+
+   /***************************************************
+    * RISING KEYS
+    * Keys that trend upward with some jitter, like
+    * timestamps or a rolling window
+    ***************************************************/
+   std::vector<int> risingKeys(size_t num, unsigned int seed = 42)
+   {
+      std::mt19937 generator(seed);
+      std::vector<int> keys(num);
+      for (size_t i = 0; i < num; i++)
+         keys[i] = int(i / 4) + int(generator() % 4096);
+      return keys;
+   }
+
+   /***************************************************
+    * SEARCH NAME
+    * The child search a priority_queue was compiled
+    * with, and the vector instruction set if any
+    ***************************************************/
+   template <class PQ>
+   static const char * searchName()
+   {
+      typedef typename PQ::search search;
+      return std::is_same<search, typename PQ::search_scalar>::value     ? "scalar"     :
+             std::is_same<search, typename PQ::search_branchless>::value ? "branchless" : "vector";
+   }
+
+   static const char * simdName()
+   {
+#if defined(PQUEUE_SIMD_AVX2)
+      return "AVX2";
+#elif defined(PQUEUE_SIMD_SSE4)
+      return "SSE4.2";
+#else
+      return "none, vector rows run the branchless search";
+#endif
+   }
+
+   /***************************************************
+    * TIME
+    * Wall-clock milliseconds to execute the workload
+    ***************************************************/
+   template <class Workload>
+   double time(Workload workload)
+   {
+      auto begin = std::chrono::steady_clock::now();
+      workload();
+      auto end = std::chrono::steady_clock::now();
+      return std::chrono::duration<double, std::milli>(end - begin).count();
+   }
+
+   /***************************************************
+    * BRANCH MISSES
+    * Execute the workload and return the number of
+    * mispredicted branches it took, or -1 when there
+    * is no hardware counter to read (not Linux, or no
+    * access to perf events)
+    ***************************************************/
+   template <class Workload>
+   long long branchMisses(Workload workload)
+   {
+#ifdef __linux__
+      perf_event_attr attr = {};
+      attr.size           = sizeof(attr);
+      attr.type           = PERF_TYPE_HARDWARE;
+      attr.config         = PERF_COUNT_HW_BRANCH_MISSES;
+      attr.disabled       = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      int fd = int(syscall(SYS_perf_event_open, &attr, 0 /*this process*/, -1 /*any cpu*/, -1, 0));
+      if (fd >= 0)
+      {
+         ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+         ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+         workload();
+         ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+         long long numMisses = -1;
+         if (::read(fd, &numMisses, sizeof(numMisses)) != sizeof(numMisses))
+            numMisses = -1;
+         ::close(fd);
+         return numMisses;
+      }
+#endif // __linux__
+      workload();
+      return -1;
+   }
+
+   /***************************************************
+    * REPORT
+    * Display one timing, and the time per operation
+    * when the number of operations is known
+    ***************************************************/
+   void report(const std::string & name, double ms, size_t numOps = 0)
+   {
+      std::cout << "\t" << std::left << std::setw(40) << name
+                << std::right << std::setw(12) << std::fixed
+                << std::setprecision(2) << ms << " ms";
+      if (numOps)
+         std::cout << std::setw(10) << (ms * 1000000.0 / double(numOps)) << " ns/op";
+      std::cout << "\n";
+   }
+
+   static const size_t numTopK = 1000;  // the bound on the top-k heaps
+   size_t numItems;       // the number of items in each workload
+   long long checksum;    // sum of everything popped
+};
+
+#endif // BENCHMARK
@@ -0,0 +1,317 @@
+/***********************************************************************
+ * Header:
+ *    INDEXED PRIORITY QUEUE
+ * Summary:
+ *    A priority queue that hands out a handle for every push, so an
+ *    item can later be given a new priority or removed wherever it is
+ *    in the heap
+ *
+ *    This will contain the class definition of:
+ *        indexed_priority_queue  : A priority queue with handles
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>      // for uint32_t and uint64_t
+#include <functional>   // for std::less
+#include "priority_queue.h"
+#include "vector.h"
+
+class TestIPQueue;    // forward declaration for unit test class
+class BenchPQueue;    // forward declaration for the benchmarks
+
+namespace custom
+{
+
+/*************************************************
+ * INDEXED PRIORITY QUEUE
+ * A heap of items, each tagged with a handle. The
+ * position table maps every handle to where its
+ * item sits in the heap. The heap is a
+ * priority_queue whose Track writes each new
+ * position back as its sifts move items, so update()
+ * and erase() find their item in O(1) and repair the
+ * heap in O(log n) with the same sifts, child search
+ * and layout as priority_queue. Slots of removed
+ * items are recycled, so the table stays as big as
+ * the most items ever queued at once.
+ * A handle carries the generation of its slot, so a
+ * handle whose item already left the queue names
+ * nothing, even after the slot is reused: contains()
+ * says FALSE, and get, update and erase throw.
+ *************************************************/
+template<class T, class Compare = std::less<T>, size_t Arity = 2,
+         class PopStrategy = pop_top_down, class Layout = layout_flat>
+class indexed_priority_queue
+{
+   friend class ::TestIPQueue; // give the unit test class access to the privates
+   friend class ::BenchPQueue;
+public:
+   typedef uint64_t handle;
+
+   //
+   // construct
+   //
+   indexed_priority_queue() = default;
+   explicit indexed_priority_queue(const Compare & compare) : heap(entry_compare(compare)) {}
+
+   //
+   // Access
+   //
+   const T & top() const         { return heap.top().value;           }
+   handle    top_handle() const  { return handleOf(heap.top().slot); }
+   const T & get(handle h) const;
+   bool      contains(handle h) const
+   {
+      uint32_t slot = uint32_t(h);
+      return slot < positions().size() && positions()[slot] != 0 &&
+             generations[slot] == uint32_t(h >> 32);
+   }
+
+   //
+   // Insert
+   //
+   handle push(const T & t);
+   handle push(T && t);
+
+   //
+   // Change
+   //
+   void   update(handle h, const T & t);
+   void   update(handle h, T && t);
+
+   //
+   // Remove
+   //
+   void   pop();
+   T      pop_value();
+   void   erase(handle h);
+
+   //
+   // Status
+   //
+   size_t size()  const { return heap.size();  }
+   bool   empty() const { return heap.empty(); }
+   void   reserve(size_t num);
+
+private:
+
+   // an item and the slot of the handle it was pushed under
+   struct entry
+   {
+      T value;
+      uint32_t slot;
+   };
+
+   // order entries by their items
+   class entry_compare : private compare_holder<Compare>
+   {
+   public:
+      entry_compare(const Compare & compare = Compare()) : compare_holder<Compare>(compare) {}
+      bool operator()(const entry & lhs, const entry & rhs) const
+      {
+         return this->comp()(lhs.value, rhs.value);
+      }
+   };
+
+   // record the heap index of every entry the heap moves
+   struct track_positions
+   {
+      custom::vector<size_t> positions;   // heap index of each slot, 0 when free
+      void placed(const entry & e, size_t indexHeap) { positions[e.slot] = indexHeap; }
+   };
+
+   typedef priority_queue <entry, entry_compare, Arity, PopStrategy, Layout, track_positions> heap_type;
+
+   uint32_t newSlot();                        // a free slot, recycled if possible
+   void   freeSlot(uint32_t slot);            // the item in the slot left the heap
+   void   removeAt(size_t indexHeap);         // take out the item at a heap index
+   void   repair(size_t indexHeap);           // percolate whichever way is needed
+
+   static size_t indexParent(size_t indexHeap) { return heap_type::indexParent(indexHeap); }
+   bool isLess(size_t indexLHS, size_t indexRHS) { return heap.isLess(indexLHS, indexRHS); }
+
+   heap_type                heap;
+   custom::vector<uint32_t> generations; // of each slot, bumped every time it is freed
+   custom::vector<uint32_t> freeSlots;   // slots ready to be reused
+
+   // The heap is 1-based: index 1 is the root
+   entry & containerAt(size_t indexHeap)             { return heap.containerAt(indexHeap);    }
+   const entry & containerAt(size_t indexHeap) const { return heap.containerAt(indexHeap);    }
+   size_t indexBack() const                          { return heap.indexBack();              }
+   custom::vector<size_t> & positions()              { return heap.positions;                }
+   const custom::vector<size_t> & positions() const  { return heap.positions;                }
+   handle handleOf(uint32_t slot) const { return (handle(generations[slot]) << 32) | slot; }
+   size_t positionOf(handle h) const
+   {
+      if (!contains(h))
+         throw "std:out_of_range";
+      return positions()[uint32_t(h)];
+   }
+};
+
+/************************************************
+ * IP QUEUE :: GET
+ * The item queued under a handle
+ ***********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+const T & indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: get(handle h) const
+{
+   return containerAt(positionOf(h)).value;
+}
+
+/*****************************************
+ * IP QUEUE :: PUSH
+ * Add a new element to the heap and return
+ * the handle that names it from now on
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+typename indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: handle
+indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: push(const T & t)
+{
+   return push(T(t));
+}
+
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+typename indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: handle
+indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: push(T && t)
+{
+   uint32_t slot = newSlot();
+   heap.push(entry{ std::move(t), slot });
+   return handleOf(slot);
+}
+
+/*****************************************
+ * IP QUEUE :: UPDATE
+ * Give a queued item a new value, then move it
+ * up or down to where the new value belongs
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+void indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: update(handle h, const T & t)
+{
+   update(h, T(t));
+}
+
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+void indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: update(handle h, T && t)
+{
+   size_t indexHeap = positionOf(h);
+   containerAt(indexHeap).value = std::move(t);
+   repair(indexHeap);
+}
+
+/**********************************************
+ * IP QUEUE :: POP
+ * Delete the top item from the heap the way
+ * PopStrategy says
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+void indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: pop()
+{
+   if (heap.empty())
+      return;
+   freeSlot(containerAt(1).slot);
+   heap.pop();
+}
+
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+T indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: pop_value()
+{
+   if (heap.empty())
+      throw "std:out_of_range";
+   T value(std::move(containerAt(1).value));
+   pop();
+   return value;
+}
+
+/**********************************************
+ * IP QUEUE :: ERASE
+ * Delete a queued item, wherever it is
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+void indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: erase(handle h)
+{
+   removeAt(positionOf(h));
+}
+
+/**********************************************
+ * IP QUEUE :: RESERVE
+ * Make room for num items without growing
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+void indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: reserve(size_t num)
+{
+   heap.container.reserve(num);
+   positions().reserve(num);
+   generations.reserve(num);
+}
+
+/**********************************************
+ * IP QUEUE :: NEW SLOT
+ * Reuse a freed slot, or make the table bigger
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+uint32_t indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: newSlot()
+{
+   if (!freeSlots.empty())
+   {
+      uint32_t slot = freeSlots.back();
+      freeSlots.pop_back();
+      return slot;
+   }
+   positions().push_back(0);
+   generations.push_back(0);
+   return uint32_t(positions().size() - 1);
+}
+
+/**********************************************
+ * IP QUEUE :: FREE SLOT
+ * The slot's item left the heap. Bump the
+ * generation so old handles no longer match,
+ * and keep the slot for reuse
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+void indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: freeSlot(uint32_t slot)
+{
+   positions()[slot] = 0;
+   generations[slot]++;
+   freeSlots.push_back(slot);
+}
+
+/**********************************************
+ * IP QUEUE :: REMOVE AT
+ * Free the slot of the item at indexHeap, move
+ * the last item into its place, and repair
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+void indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: removeAt(size_t indexHeap)
+{
+   assert(indexHeap >= 1 && indexHeap <= indexBack());
+   freeSlot(containerAt(indexHeap).slot);
+
+   if (indexHeap != indexBack())
+   {
+      heap.place(indexHeap, std::move(containerAt(indexBack())));
+      heap.container.pop_back();
+      repair(indexHeap);
+   }
+   else
+      heap.container.pop_back();
+}
+
+/************************************************
+ * IP QUEUE :: REPAIR
+ * The item at indexHeap changed. It can only be
+ * out of order with its parent or its children.
+ ************************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+void indexed_priority_queue <T, Compare, Arity, PopStrategy, Layout> :: repair(size_t indexHeap)
+{
+   if (!heap.percolateUp(indexHeap))
+      heap.percolateDown(indexHeap);
+}
+
+} // namespace custom
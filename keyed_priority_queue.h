@@ -0,0 +1,148 @@
+/***********************************************************************
+ * Header:
+ *    KEYED PRIORITY QUEUE
+ * Summary:
+ *    A priority queue ordered by a key computed from each item. The key
+ *    is computed once, when the item goes in, and kept next to it
+ *
+ *    This will contain the class definition of:
+ *        keyed_priority_queue    : A priority queue with cached keys
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#include <functional>   // for std::less
+#include <iterator>     // for std::distance
+#include <type_traits>  // for std::invoke_result
+#include "priority_queue.h"
+#include "vector.h"
+
+class TestKeyedPQueue;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * KEYED ENTRY
+ * An item and its cached key
+ *************************************************/
+template <class Key, class T>
+struct keyed_entry
+{
+   Key key;
+   T value;
+};
+
+/*************************************************
+ * KEYED COMPARE
+ * Order entries by KeyCompare on their cached keys.
+ * The items themselves are never looked at.
+ *************************************************/
+template <class Key, class T, class KeyCompare>
+class keyed_compare : private compare_holder<KeyCompare>
+{
+public:
+   keyed_compare(const KeyCompare & compare = KeyCompare()) : compare_holder<KeyCompare>(compare) {}
+   bool operator()(const keyed_entry<Key, T> & lhs, const keyed_entry<Key, T> & rhs) const
+   {
+      return this->comp()(lhs.key, rhs.key);
+   }
+};
+
+/*************************************************
+ * KEYED PRIORITY QUEUE
+ * Like priority_queue<T, compare_by<KeyOf, KeyCompare>>,
+ * except that KeyOf runs once per item rather than
+ * twice per comparison. Worth it when the key is
+ * costly to derive: a score from several fields, or
+ * a string. Each item carries a copy of its key, so
+ * the key must not change while the item is queued.
+ *************************************************/
+template<class T, class KeyOf, class KeyCompare = std::less<void>, size_t Arity = 2,
+         class PopStrategy = pop_top_down>
+class keyed_priority_queue : private compare_holder<KeyOf>
+{
+   friend class ::TestKeyedPQueue; // give the unit test class access to the privates
+public:
+   typedef typename std::decay<typename std::invoke_result<KeyOf, const T &>::type>::type key_type;
+
+   //
+   // construct
+   //
+   keyed_priority_queue() = default;
+   explicit keyed_priority_queue(const KeyOf & keyOf, const KeyCompare & compare = KeyCompare()) :
+      compare_holder<KeyOf>(keyOf), heap(keyed_compare<key_type, T, KeyCompare>(compare)) {}
+   template <class Iterator>
+   keyed_priority_queue(Iterator first, Iterator last,
+                        const KeyOf & keyOf = KeyOf(), const KeyCompare & compare = KeyCompare());
+
+   //
+   // Access
+   //
+   const T &        top()     const { return heap.top().value; }
+   const key_type & top_key() const { return heap.top().key;   }
+
+   //
+   // Insert
+   //
+   void push(const T & t)             { heap.push(entry{ this->comp()(t), t });            }
+   void push(T && t)                  { key_type key = this->comp()(t);
+                                        heap.push(entry{ std::move(key), std::move(t) });  }
+   template <class ... Args>
+   void emplace(Args && ... args)     { push(T(std::forward<Args>(args)...));              }
+
+   //
+   // Remove
+   //
+   void pop()                         { heap.pop();                                        }
+   T    pop_value()                   { return std::move(heap.pop_value().value);          }
+
+   //
+   // Status
+   //
+   size_t size()  const { return heap.size();  }
+   bool   empty() const { return heap.empty(); }
+
+private:
+   typedef keyed_entry<key_type, T> entry;
+
+   template <class Iterator>
+   static custom::vector<entry> entriesOf(Iterator first, Iterator last, const KeyOf & keyOf);
+
+   priority_queue <entry, keyed_compare<key_type, T, KeyCompare>, Arity, PopStrategy> heap;
+};
+
+/*****************************************
+ * KEYED P QUEUE :: RANGE CONSTRUCTOR
+ * Compute every key once, then build the
+ * heap bottom-up
+ ****************************************/
+template <class T, class KeyOf, class KeyCompare, size_t Arity, class PopStrategy>
+template <class Iterator>
+keyed_priority_queue <T, KeyOf, KeyCompare, Arity, PopStrategy> ::
+keyed_priority_queue(Iterator first, Iterator last, const KeyOf & keyOf, const KeyCompare & compare) :
+   compare_holder<KeyOf>(keyOf),
+   heap(entriesOf(first, last, keyOf), keyed_compare<key_type, T, KeyCompare>(compare))
+{
+}
+
+/*****************************************
+ * KEYED P QUEUE :: ENTRIES OF
+ * Pair every item in a range with its key
+ ****************************************/
+template <class T, class KeyOf, class KeyCompare, size_t Arity, class PopStrategy>
+template <class Iterator>
+custom::vector<typename keyed_priority_queue <T, KeyOf, KeyCompare, Arity, PopStrategy> :: entry>
+keyed_priority_queue <T, KeyOf, KeyCompare, Arity, PopStrategy> ::
+entriesOf(Iterator first, Iterator last, const KeyOf & keyOf)
+{
+   custom::vector<entry> entries;
+   entries.reserve(std::distance(first, last));
+   for (auto it = first; it != last; ++it)
+      entries.push_back(entry{ keyOf(*it), *it });
+   return entries;
+}
+
+} // namespace custom
@@ -0,0 +1,292 @@
+/***********************************************************************
+ * Header:
+ *    LAZY PRIORITY QUEUE
+ * Summary:
+ *    A priority queue where any queued item can be cancelled in O(1).
+ *    Cancelled items stay in the heap as tombstones until they reach
+ *    the top or the heap is compacted
+ *
+ *    This will contain the class definition of:
+ *        lazy_priority_queue     : A priority queue with O(1) cancel
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>      // for uint32_t and uint64_t
+#include <functional>   // for std::less
+#include "priority_queue.h"
+#include "vector.h"
+
+class TestLazyPQueue;    // forward declaration for unit test class
+class BenchPQueue;       // forward declaration for the benchmarks
+
+namespace custom
+{
+
+/*************************************************
+ * LAZY ENTRY
+ * An item and the slot that says whether it is live
+ *************************************************/
+template <class T>
+struct lazy_entry
+{
+   T value;
+   uint32_t slot;
+};
+
+/*************************************************
+ * LAZY COMPARE
+ * Order entries by Compare on their items
+ *************************************************/
+template <class T, class Compare>
+class lazy_compare : private compare_holder<Compare>
+{
+public:
+   lazy_compare(const Compare & compare = Compare()) : compare_holder<Compare>(compare) {}
+   bool operator()(const lazy_entry<T> & lhs, const lazy_entry<T> & rhs) const
+   {
+      return this->comp()(lhs.value, rhs.value);
+   }
+};
+
+/*************************************************
+ * LAZY PRIORITY QUEUE
+ * A priority queue whose push returns a handle that
+ * can cancel the item. Cancel only marks the item's
+ * slot dead. Dead items are dropped when they reach
+ * the top, so top() and pop() never see them, and
+ * once more than max_dead_ratio() of the heap is
+ * dead, all of them are dropped at once and the heap
+ * is rebuilt in linear time.
+ * A handle carries the generation of its slot, so a
+ * handle whose item already left the queue cancels
+ * nothing, even after the slot is reused.
+ *************************************************/
+template<class T, class Compare = std::less<T>, size_t Arity = 2,
+         class PopStrategy = pop_top_down>
+class lazy_priority_queue
+{
+   friend class ::TestLazyPQueue; // give the unit test class access to the privates
+   friend class ::BenchPQueue;
+   typedef lazy_entry<T> entry;
+public:
+   typedef uint64_t handle;
+
+   //
+   // construct
+   //
+   lazy_priority_queue() : numDead(0), maxDeadRatio(0.5) {}
+   explicit lazy_priority_queue(const Compare & compare) :
+      heap(lazy_compare<T, Compare>(compare)), numDead(0), maxDeadRatio(0.5) {}
+
+   //
+   // Access
+   //
+   const T & top() const { return heap.top().value; }
+
+   //
+   // Insert
+   //
+   handle push(const T & t);
+   handle push(T && t);
+
+   //
+   // Remove
+   //
+   void   pop();
+   T      pop_value();
+   bool   cancel(handle h);
+
+   //
+   // Status
+   //
+   size_t size()  const { return heap.size() - numDead; }
+   bool   empty() const { return size() == 0;           }
+   bool   contains(handle h) const;
+   double max_dead_ratio() const { return maxDeadRatio; }
+   void   max_dead_ratio(double ratio);
+
+private:
+   // what a slot knows about the item that holds it
+   enum : uint32_t { SLOT_FREE, SLOT_LIVE, SLOT_DEAD };
+   struct slot_state
+   {
+      uint32_t generation;   // bumped every time the slot is freed
+      uint32_t state;
+   };
+
+   uint32_t newSlot();                      // a free slot, recycled if possible
+   void     freeSlot(uint32_t slot);
+   void     dropDeadTop();                  // pop tombstones off the top
+   void     compact();                      // drop every tombstone and rebuild
+
+   priority_queue <entry, lazy_compare<T, Compare>, Arity, PopStrategy> heap;
+   custom::vector<slot_state> slots;        // state of every slot
+   custom::vector<uint32_t>   freeSlots;    // slots ready to be reused
+   size_t numDead;                          // tombstones still in the heap
+   double maxDeadRatio;                     // compact past this share of tombstones
+};
+
+/*****************************************
+ * LAZY P QUEUE :: PUSH
+ * Add an item and return the handle that
+ * can cancel it
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+typename lazy_priority_queue <T, Compare, Arity, PopStrategy> :: handle
+lazy_priority_queue <T, Compare, Arity, PopStrategy> :: push(const T & t)
+{
+   return push(T(t));
+}
+
+template <class T, class Compare, size_t Arity, class PopStrategy>
+typename lazy_priority_queue <T, Compare, Arity, PopStrategy> :: handle
+lazy_priority_queue <T, Compare, Arity, PopStrategy> :: push(T && t)
+{
+   uint32_t slot = newSlot();
+   heap.push(entry{ std::move(t), slot });
+   return (handle(slots[slot].generation) << 32) | slot;
+}
+
+/**********************************************
+ * LAZY P QUEUE :: POP
+ * Delete the top item, then any tombstones it
+ * was hiding
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+void lazy_priority_queue <T, Compare, Arity, PopStrategy> :: pop()
+{
+   if (heap.empty())
+      return;
+   freeSlot(heap.top().slot);
+   heap.pop();
+   dropDeadTop();
+}
+
+template <class T, class Compare, size_t Arity, class PopStrategy>
+T lazy_priority_queue <T, Compare, Arity, PopStrategy> :: pop_value()
+{
+   entry e(heap.pop_value());
+   freeSlot(e.slot);
+   dropDeadTop();
+   return std::move(e.value);
+}
+
+/**********************************************
+ * LAZY P QUEUE :: CANCEL
+ * Mark a queued item dead. Return FALSE if the
+ * handle no longer names a queued item.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+bool lazy_priority_queue <T, Compare, Arity, PopStrategy> :: cancel(handle h)
+{
+   if (!contains(h))
+      return false;
+
+   slots[uint32_t(h)].state = SLOT_DEAD;
+   numDead++;
+   if (heap.top().slot == uint32_t(h))
+      dropDeadTop();
+   else if (double(numDead) > maxDeadRatio * double(heap.size()))
+      compact();
+   return true;
+}
+
+/**********************************************
+ * LAZY P QUEUE :: CONTAINS
+ * Is the item named by the handle still queued?
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+bool lazy_priority_queue <T, Compare, Arity, PopStrategy> :: contains(handle h) const
+{
+   uint32_t slot = uint32_t(h);
+   return slot < slots.size() &&
+          slots[slot].generation == uint32_t(h >> 32) &&
+          slots[slot].state == SLOT_LIVE;
+}
+
+/**********************************************
+ * LAZY P QUEUE :: MAX DEAD RATIO
+ * Set the share of tombstones, 0.0 to 1.0, the heap
+ * may hold before it is compacted
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+void lazy_priority_queue <T, Compare, Arity, PopStrategy> :: max_dead_ratio(double ratio)
+{
+   maxDeadRatio = ratio;
+   if (double(numDead) > maxDeadRatio * double(heap.size()))
+      compact();
+}
+
+/**********************************************
+ * LAZY P QUEUE :: NEW SLOT
+ * Reuse a freed slot, or make the table bigger
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+uint32_t lazy_priority_queue <T, Compare, Arity, PopStrategy> :: newSlot()
+{
+   uint32_t slot;
+   if (!freeSlots.empty())
+   {
+      slot = freeSlots.back();
+      freeSlots.pop_back();
+   }
+   else
+   {
+      slot = uint32_t(slots.size());
+      slots.push_back(slot_state{ 0, SLOT_FREE });
+   }
+   slots[slot].state = SLOT_LIVE;
+   return slot;
+}
+
+/**********************************************
+ * LAZY P QUEUE :: FREE SLOT
+ * The slot's item left the heap. Bump the
+ * generation so old handles no longer match.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+void lazy_priority_queue <T, Compare, Arity, PopStrategy> :: freeSlot(uint32_t slot)
+{
+   slots[slot].generation++;
+   slots[slot].state = SLOT_FREE;
+   freeSlots.push_back(slot);
+}
+
+/**********************************************
+ * LAZY P QUEUE :: DROP DEAD TOP
+ * Pop tombstones until a live item is on top, so
+ * top() never has to skip anything
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+void lazy_priority_queue <T, Compare, Arity, PopStrategy> :: dropDeadTop()
+{
+   while (numDead && slots[heap.top().slot].state == SLOT_DEAD)
+   {
+      freeSlot(heap.top().slot);
+      heap.pop();
+      numDead--;
+   }
+}
+
+/**********************************************
+ * LAZY P QUEUE :: COMPACT
+ * Drop every tombstone in one pass, freeing their
+ * slots, and rebuild the heap bottom-up. O(n).
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+void lazy_priority_queue <T, Compare, Arity, PopStrategy> :: compact()
+{
+   heap.erase_if([this](const entry & e)
+   {
+      if (slots[e.slot].state != SLOT_DEAD)
+         return false;
+      freeSlot(e.slot);
+      return true;
+   });
+   numDead = 0;
+}
+
+} // namespace custom
@@ -0,0 +1,301 @@
+/***********************************************************************
+ * Header:
+ *    MINMAX HEAP
+ * Summary:
+ *    A double-ended priority queue: both the largest and the smallest
+ *    item are at hand, in one array
+ *
+ *    This will contain the class definition of:
+ *        minmax_heap             : A double-ended priority queue
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#include <functional>   // for std::less
+#include <utility>      // for std::swap
+#include "priority_queue.h"
+#include "vector.h"
+
+class TestMinmaxHeap;    // forward declaration for unit test class
+class BenchPQueue;       // forward declaration for the benchmarks
+
+namespace custom
+{
+
+/*************************************************
+ * MINMAX HEAP
+ * A min-max heap (Atkinson, Sack, Santoro, Strothotte).
+ * The levels of the tree take turns: the root and
+ * every other level below it are min levels, where an
+ * item is no bigger than anything under it, and the
+ * levels in between are max levels, where an item is
+ * no smaller. So the smallest item is the root and the
+ * largest is one of its children.
+ * One array holds every item once, where a bounded
+ * queue that must both dispatch its best and evict
+ * its worst would otherwise keep two heaps in step.
+ *************************************************/
+template<class T, class Compare = std::less<T> >
+class minmax_heap : private compare_holder<Compare>
+{
+   friend class ::TestMinmaxHeap; // give the unit test class access to the privates
+   friend class ::BenchPQueue;
+public:
+
+   //
+   // construct
+   //
+   minmax_heap() = default;
+   explicit minmax_heap(const Compare & compare) : compare_holder<Compare>(compare) {}
+
+   //
+   // Access
+   //
+   const T & top_min() const;
+   const T & top_max() const;
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+   void push(T && t);
+
+   //
+   // Remove
+   //
+   void pop_min();
+   void pop_max();
+
+   //
+   // Status
+   //
+   size_t size()  const { return container.size();  }
+   bool   empty() const { return container.empty(); }
+
+private:
+   void   percolateUp(size_t indexHeap);
+   void   percolateUpLevel(size_t indexHeap, bool isMax);  // among grandparents only
+   void   percolateDown(size_t indexHeap);
+   size_t indexMax() const;                   // where the largest item is
+
+   // navigate the tree. These are heap indices, the root is 1
+   static size_t indexParent(size_t indexHeap)      { return indexHeap / 2; }
+   static size_t indexFirstChild(size_t indexHeap)  { return indexHeap * 2; }
+   static bool   isMaxLevel(size_t indexHeap);
+
+   // does the lhs belong above the rhs on a level of this kind?
+   bool isAbove(const T & lhs, const T & rhs, bool isMax) const
+   {
+      return isMax ? this->comp()(rhs, lhs) : this->comp()(lhs, rhs);
+   }
+
+   custom::vector<T> container;
+
+   T & containerAt(size_t indexHeap)             { return container[indexHeap - 1]; }
+   const T & containerAt(size_t indexHeap) const { return container[indexHeap - 1]; }
+};
+
+/************************************************
+ * MINMAX HEAP :: TOP MIN
+ * The smallest item: the root
+ ***********************************************/
+template <class T, class Compare>
+const T & minmax_heap <T, Compare> :: top_min() const
+{
+   if (container.empty())
+      throw "std:out_of_range";
+   return containerAt(1);
+}
+
+/************************************************
+ * MINMAX HEAP :: TOP MAX
+ * The largest item: the bigger child of the root,
+ * or the root when it is alone
+ ***********************************************/
+template <class T, class Compare>
+const T & minmax_heap <T, Compare> :: top_max() const
+{
+   if (container.empty())
+      throw "std:out_of_range";
+   return containerAt(indexMax());
+}
+
+/*****************************************
+ * MINMAX HEAP :: PUSH
+ * Add an item at the end and move it up
+ ****************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: push(const T & t)
+{
+   container.push_back(t);
+   percolateUp(size());
+}
+
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: push(T && t)
+{
+   container.push_back(std::move(t));
+   percolateUp(size());
+}
+
+/**********************************************
+ * MINMAX HEAP :: POP MIN
+ * Move the last item into the root and percolate
+ * it down
+ **********************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: pop_min()
+{
+   if (size() > 1)
+   {
+      containerAt(1) = std::move(containerAt(size()));
+      container.pop_back();
+      percolateDown(1);
+   }
+   else
+      container.pop_back();
+}
+
+/**********************************************
+ * MINMAX HEAP :: POP MAX
+ * Move the last item into the place of the largest
+ * and percolate it down
+ **********************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: pop_max()
+{
+   size_t indexHeap = indexMax();
+   if (indexHeap < size())
+   {
+      containerAt(indexHeap) = std::move(containerAt(size()));
+      container.pop_back();
+      percolateDown(indexHeap);
+   }
+   else
+      container.pop_back();
+}
+
+/************************************************
+ * MINMAX HEAP :: PERCOLATE UP
+ * The item at the passed index is new. If it belongs
+ * on the other kind of level than its own, trade
+ * places with the parent first. Then it only has to
+ * climb past grandparents, which are on its kind of
+ * level.
+ ************************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: percolateUp(size_t indexHeap)
+{
+   if (indexHeap == 1)
+      return;
+
+   bool isMax = isMaxLevel(indexHeap);
+   size_t indexAbove = indexParent(indexHeap);
+   if (isAbove(containerAt(indexAbove), containerAt(indexHeap), isMax))
+   {
+      std::swap(containerAt(indexAbove), containerAt(indexHeap));
+      percolateUpLevel(indexAbove, !isMax);
+   }
+   else
+      percolateUpLevel(indexHeap, isMax);
+}
+
+/************************************************
+ * MINMAX HEAP :: PERCOLATE UP LEVEL
+ * Lift the item past each grandparent it belongs
+ * above, moving the grandparents down into the hole
+ ************************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: percolateUpLevel(size_t indexHeap, bool isMax)
+{
+   if (indexHeap < 4 || !isAbove(containerAt(indexHeap), containerAt(indexHeap / 4), isMax))
+      return;
+
+   T value(std::move(containerAt(indexHeap)));
+   size_t indexHole = indexHeap;
+   do
+   {
+      containerAt(indexHole) = std::move(containerAt(indexHole / 4));
+      indexHole /= 4;
+   }
+   while (indexHole >= 4 && isAbove(value, containerAt(indexHole / 4), isMax));
+
+   containerAt(indexHole) = std::move(value);
+}
+
+/************************************************
+ * MINMAX HEAP :: PERCOLATE DOWN
+ * The item at the passed index may be out of order.
+ * On its kind of level, find the best of its children
+ * and grandchildren. A grandchild that beats the item
+ * moves up into the hole and the item goes on down,
+ * after trading places with the grandchild's parent
+ * if it belongs on that level instead. A child that
+ * beats the item just trades places, and that is all.
+ ************************************************/
+template <class T, class Compare>
+void minmax_heap <T, Compare> :: percolateDown(size_t indexHeap)
+{
+   bool isMax = isMaxLevel(indexHeap);
+   T value(std::move(containerAt(indexHeap)));
+   size_t indexHole = indexHeap;
+   size_t num = size();
+
+   for (;;)
+   {
+      // the best of up to two children and four grandchildren
+      size_t indexChild = indexFirstChild(indexHole);
+      if (indexChild > num)
+         break;
+      size_t indexBest = indexChild;
+      if (indexChild + 1 <= num && isAbove(containerAt(indexChild + 1), containerAt(indexBest), isMax))
+         indexBest = indexChild + 1;
+      size_t indexGrandchild = indexFirstChild(indexChild);
+      for (size_t i = indexGrandchild; i < indexGrandchild + 4 && i <= num; i++)
+         if (isAbove(containerAt(i), containerAt(indexBest), isMax))
+            indexBest = i;
+
+      if (!isAbove(containerAt(indexBest), value, isMax))
+         break;
+      containerAt(indexHole) = std::move(containerAt(indexBest));
+      indexHole = indexBest;
+      if (indexBest < indexGrandchild)
+         break;
+
+      // the item may belong on the parent's kind of level
+      size_t indexAbove = indexParent(indexHole);
+      if (isAbove(value, containerAt(indexAbove), !isMax))
+         std::swap(value, containerAt(indexAbove));
+   }
+
+   containerAt(indexHole) = std::move(value);
+}
+
+/************************************************
+ * MINMAX HEAP :: INDEX MAX
+ * The root is the largest only when it is alone
+ ************************************************/
+template <class T, class Compare>
+size_t minmax_heap <T, Compare> :: indexMax() const
+{
+   if (size() < 3)
+      return size();
+   return this->comp()(containerAt(2), containerAt(3)) ? 3 : 2;
+}
+
+/************************************************
+ * MINMAX HEAP :: IS MAX LEVEL
+ * The root is on level 0, a min level
+ ************************************************/
+template <class T, class Compare>
+bool minmax_heap <T, Compare> :: isMaxLevel(size_t indexHeap)
+{
+   bool isMax = false;
+   for (; indexHeap > 1; indexHeap /= 2)
+      isMax = !isMax;
+   return isMax;
+}
+
+} // namespace custom
@@ -0,0 +1,584 @@
+/***********************************************************************
+ * Header:
+ *    PAIRING HEAP
+ * Summary:
+ *    A node-based priority queue with O(1) meld and cheap amortized
+ *    decrease-key, its nodes carved out of pooled blocks
+ *
+ *    This will contain the class definition of:
+ *        node_pool               : Fixed-size nodes from pooled blocks
+ *        pairing_heap            : A pairing heap with handles
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#include <cassert>
+#include <functional>   // for std::less
+#include <new>          // for placement new
+#include <type_traits>  // for std::aligned_storage
+#include <utility>      // for std::swap and std::forward
+#include "priority_queue.h"
+#include "vector.h"
+
+class TestPairingHeap;    // forward declaration for unit test class
+class BenchPQueue;        // forward declaration for the benchmarks
+
+namespace custom
+{
+
+/*************************************************
+ * NODE POOL
+ * Hands out storage for one Node at a time from
+ * blocks of BlockNodes, so a push does not go to the
+ * global heap. A destroyed node goes on a free list
+ * and is the next to be handed out. Blocks are only
+ * given back when the pool dies, and splice() hands
+ * every block of another pool over in O(1).
+ *************************************************/
+template <class Node, size_t BlockNodes = 256>
+class node_pool
+{
+   friend class ::TestPairingHeap; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   node_pool() : blockFirst(nullptr), blockLast(nullptr), freeFirst(nullptr), freeLast(nullptr) {}
+   node_pool(node_pool && rhs) : node_pool() { swap(rhs); }
+   node_pool(const node_pool &) = delete;
+   node_pool & operator = (const node_pool &) = delete;
+  ~node_pool();
+
+   //
+   // Allocate
+   //
+   template <class ... Args>
+   Node * create(Args && ... args);
+   void   destroy(Node * pNode);
+   void   splice(node_pool & rhs);
+   void   swap(node_pool & rhs);
+
+private:
+   // a node, or a link in the free list when it is not in use
+   union slot
+   {
+      slot * pNext;
+      typename std::aligned_storage<sizeof(Node), alignof(Node)>::type storage;
+   };
+
+   struct block
+   {
+      block * pNext;
+      slot slots[BlockNodes];
+   };
+
+   void addBlock();                          // thread a new block onto the free list
+
+   block * blockFirst;
+   block * blockLast;
+   slot  * freeFirst;
+   slot  * freeLast;
+};
+
+/*************************************************
+ * PAIRING HEAP
+ * A pairing heap (Fredman, Sedgewick, Sleator, Tarjan).
+ * Every node holds an item no smaller than its
+ * children, which hang off it as a list. Two heaps
+ * meld by hanging the lesser root under the other
+ * one, so push and meld are O(1). pop takes the root
+ * away and melds its children in two passes, pairing
+ * them left to right and then folding the pairs right
+ * to left, which is O(log n) amortized.
+ * A handle is a node: decrease_key() raises an item,
+ * cuts its subtree loose and melds it with the root,
+ * in O(1) time (o(log n) amortized, as analyzed).
+ * The heap is made of pointers rather than an array,
+ * so prefer priority_queue when nothing needs melding
+ * and no queued item ever changes.
+ *************************************************/
+template<class T, class Compare = std::less<T> >
+class pairing_heap : private compare_holder<Compare>
+{
+   friend class ::TestPairingHeap; // give the unit test class access to the privates
+   friend class ::BenchPQueue;
+
+   // an item and the links that place it in the tree
+   struct node
+   {
+      template <class ... Args>
+      node(Args && ... args) : value(std::forward<Args>(args)...),
+         pChild(nullptr), pSibling(nullptr), pPrev(nullptr) {}
+      T value;
+      node * pChild;      // the leftmost child
+      node * pSibling;    // the next sibling to the right
+      node * pPrev;       // the sibling to the left, or the parent of a leftmost child
+   };
+
+public:
+   typedef node * handle;
+
+   //
+   // construct
+   //
+   pairing_heap() : pRoot(nullptr), numElements(0) {}
+   explicit pairing_heap(const Compare & compare) :
+      compare_holder<Compare>(compare), pRoot(nullptr), numElements(0) {}
+   pairing_heap(pairing_heap && rhs) :
+      compare_holder<Compare>(rhs), pRoot(nullptr), numElements(0) { swap(rhs); }
+   pairing_heap(const pairing_heap &) = delete;
+   pairing_heap & operator = (pairing_heap && rhs);
+   pairing_heap & operator = (const pairing_heap &) = delete;
+  ~pairing_heap() { clear(); }
+
+   //
+   // Access
+   //
+   const T & top() const;
+   handle    top_handle() const;
+   const T & get(handle h) const { return h->value; }
+
+   //
+   // Insert
+   //
+   handle push(const T & t);
+   handle push(T && t);
+   template <class ... Args>
+   handle emplace(Args && ... args);
+   void   meld(pairing_heap && rhs);
+
+   //
+   // Change
+   //
+   void   decrease_key(handle h, const T & t);
+   void   decrease_key(handle h, T && t);
+
+   //
+   // Remove
+   //
+   void   pop();
+   T      pop_value();
+   void   clear();
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements;      }
+   bool   empty() const { return numElements == 0; }
+   void   swap(pairing_heap & rhs);
+
+private:
+   handle insert(node * pNode);              // meld a new node with the root
+   node * link(node * pLHS, node * pRHS);    // the root of two melded trees
+   node * linkChildren(node * pFirst);       // the root of a list of siblings, melded
+   void   cut(node * pNode);                 // take a subtree out of the tree
+   void   raise(node * pNode);               // move a raised node up to where it belongs
+
+   node * pRoot;
+   size_t numElements;
+   node_pool<node> pool;
+   custom::vector<node *> pairs;             // reused by every pop
+};
+
+/************************************************
+ * NODE POOL :: DESTRUCTOR
+ * Give back every block. The nodes in them must
+ * already be destroyed.
+ ***********************************************/
+template <class Node, size_t BlockNodes>
+node_pool <Node, BlockNodes> :: ~node_pool()
+{
+   while (blockFirst)
+   {
+      block * pBlock = blockFirst;
+      blockFirst = blockFirst->pNext;
+      delete pBlock;
+   }
+}
+
+/************************************************
+ * NODE POOL :: CREATE
+ * Construct a node in the first free slot, adding
+ * a block when there is none
+ ***********************************************/
+template <class Node, size_t BlockNodes>
+template <class ... Args>
+Node * node_pool <Node, BlockNodes> :: create(Args && ... args)
+{
+   if (!freeFirst)
+      addBlock();
+   slot * pSlot = freeFirst;
+   freeFirst = freeFirst->pNext;
+   if (!freeFirst)
+      freeLast = nullptr;
+   return new (&pSlot->storage) Node(std::forward<Args>(args)...);
+}
+
+/************************************************
+ * NODE POOL :: DESTROY
+ * Destruct a node and put its slot at the front of
+ * the free list, where it is the next one used
+ ***********************************************/
+template <class Node, size_t BlockNodes>
+void node_pool <Node, BlockNodes> :: destroy(Node * pNode)
+{
+   pNode->~Node();
+   slot * pSlot = reinterpret_cast<slot *>(pNode);
+   pSlot->pNext = freeFirst;
+   if (!freeFirst)
+      freeLast = pSlot;
+   freeFirst = pSlot;
+}
+
+/************************************************
+ * NODE POOL :: SPLICE
+ * Take over every block and free slot of rhs, which
+ * is left empty. The nodes rhs handed out stay where
+ * they are.
+ ***********************************************/
+template <class Node, size_t BlockNodes>
+void node_pool <Node, BlockNodes> :: splice(node_pool & rhs)
+{
+   if (&rhs == this || !rhs.blockFirst)
+      return;
+
+   rhs.blockLast->pNext = blockFirst;
+   blockFirst = rhs.blockFirst;
+   if (!blockLast)
+      blockLast = rhs.blockLast;
+
+   if (rhs.freeFirst)
+   {
+      rhs.freeLast->pNext = freeFirst;
+      freeFirst = rhs.freeFirst;
+      if (!freeLast)
+         freeLast = rhs.freeLast;
+   }
+
+   rhs.blockFirst = rhs.blockLast = nullptr;
+   rhs.freeFirst  = rhs.freeLast  = nullptr;
+}
+
+/************************************************
+ * NODE POOL :: SWAP
+ ***********************************************/
+template <class Node, size_t BlockNodes>
+void node_pool <Node, BlockNodes> :: swap(node_pool & rhs)
+{
+   std::swap(blockFirst, rhs.blockFirst);
+   std::swap(blockLast,  rhs.blockLast);
+   std::swap(freeFirst,  rhs.freeFirst);
+   std::swap(freeLast,   rhs.freeLast);
+}
+
+/************************************************
+ * NODE POOL :: ADD BLOCK
+ * Allocate a block and thread its slots, in order,
+ * onto the free list, which is empty
+ ***********************************************/
+template <class Node, size_t BlockNodes>
+void node_pool <Node, BlockNodes> :: addBlock()
+{
+   assert(!freeFirst);
+   block * pBlock = new block;
+   pBlock->pNext = blockFirst;
+   blockFirst = pBlock;
+   if (!blockLast)
+      blockLast = pBlock;
+
+   for (size_t i = 0; i + 1 < BlockNodes; i++)
+      pBlock->slots[i].pNext = &pBlock->slots[i + 1];
+   pBlock->slots[BlockNodes - 1].pNext = nullptr;
+   freeFirst = &pBlock->slots[0];
+   freeLast  = &pBlock->slots[BlockNodes - 1];
+}
+
+/************************************************
+ * PAIRING HEAP :: ASSIGNMENT
+ * Move: drop our items and take those of rhs
+ ***********************************************/
+template <class T, class Compare>
+pairing_heap <T, Compare> & pairing_heap <T, Compare> :: operator = (pairing_heap && rhs)
+{
+   clear();
+   swap(rhs);
+   return *this;
+}
+
+/************************************************
+ * PAIRING HEAP :: TOP
+ * Get the maximum item from the heap, or its handle
+ ***********************************************/
+template <class T, class Compare>
+const T & pairing_heap <T, Compare> :: top() const
+{
+   if (!pRoot)
+      throw "std:out_of_range";
+   return pRoot->value;
+}
+
+template <class T, class Compare>
+typename pairing_heap <T, Compare> :: handle
+pairing_heap <T, Compare> :: top_handle() const
+{
+   if (!pRoot)
+      throw "std:out_of_range";
+   return pRoot;
+}
+
+/*****************************************
+ * PAIRING HEAP :: PUSH
+ * Put the item in a node of its own and meld
+ * it with the root. The handle names the item
+ * until it is popped.
+ ****************************************/
+template <class T, class Compare>
+typename pairing_heap <T, Compare> :: handle
+pairing_heap <T, Compare> :: push(const T & t)
+{
+   return insert(pool.create(t));
+}
+
+template <class T, class Compare>
+typename pairing_heap <T, Compare> :: handle
+pairing_heap <T, Compare> :: push(T && t)
+{
+   return insert(pool.create(std::move(t)));
+}
+
+/*****************************************
+ * PAIRING HEAP :: EMPLACE
+ * Construct the item in its node
+ ****************************************/
+template <class T, class Compare>
+template <class ... Args>
+typename pairing_heap <T, Compare> :: handle
+pairing_heap <T, Compare> :: emplace(Args && ... args)
+{
+   return insert(pool.create(std::forward<Args>(args)...));
+}
+
+/*****************************************
+ * PAIRING HEAP :: MELD
+ * Move every item of rhs into this heap, leaving
+ * rhs empty: one link of the roots and a splice
+ * of the pools, however big either heap is. The
+ * handles of rhs now name items of this heap.
+ * Both heaps must order their items the same way.
+ ****************************************/
+template <class T, class Compare>
+void pairing_heap <T, Compare> :: meld(pairing_heap && rhs)
+{
+   if (&rhs == this)
+      return;
+
+   pool.splice(rhs.pool);
+   pRoot = link(pRoot, rhs.pRoot);
+   numElements += rhs.numElements;
+   rhs.pRoot = nullptr;
+   rhs.numElements = 0;
+}
+
+/*****************************************
+ * PAIRING HEAP :: DECREASE KEY
+ * Give a queued item a new value that belongs no
+ * lower in the heap than the old one, such as a
+ * shorter distance in a heap ordered by
+ * std::greater. The item moves up, never down.
+ ****************************************/
+template <class T, class Compare>
+void pairing_heap <T, Compare> :: decrease_key(handle h, const T & t)
+{
+   decrease_key(h, T(t));
+}
+
+template <class T, class Compare>
+void pairing_heap <T, Compare> :: decrease_key(handle h, T && t)
+{
+   if (this->comp()(t, h->value))
+      throw "std:invalid_argument";
+   h->value = std::move(t);
+   raise(h);
+}
+
+/**********************************************
+ * PAIRING HEAP :: POP
+ * Delete the top item from the heap, and meld
+ * its children into the new root
+ **********************************************/
+template <class T, class Compare>
+void pairing_heap <T, Compare> :: pop()
+{
+   if (!pRoot)
+      return;
+   node * pOld = pRoot;
+   pRoot = linkChildren(pRoot->pChild);
+   pool.destroy(pOld);
+   numElements--;
+}
+
+template <class T, class Compare>
+T pairing_heap <T, Compare> :: pop_value()
+{
+   if (!pRoot)
+      throw "std:out_of_range";
+   T value(std::move(pRoot->value));
+   pop();
+   return value;
+}
+
+/**********************************************
+ * PAIRING HEAP :: CLEAR
+ * Destroy every node, walking the tree with the
+ * pairs vector as a stack. The blocks stay in the
+ * pool to be reused.
+ **********************************************/
+template <class T, class Compare>
+void pairing_heap <T, Compare> :: clear()
+{
+   if (pRoot)
+      pairs.push_back(pRoot);
+   while (!pairs.empty())
+   {
+      node * pNode = pairs.back();
+      pairs.pop_back();
+      if (pNode->pSibling)
+         pairs.push_back(pNode->pSibling);
+      if (pNode->pChild)
+         pairs.push_back(pNode->pChild);
+      pool.destroy(pNode);
+   }
+   pRoot = nullptr;
+   numElements = 0;
+}
+
+/**********************************************
+ * PAIRING HEAP :: SWAP
+ **********************************************/
+template <class T, class Compare>
+void pairing_heap <T, Compare> :: swap(pairing_heap & rhs)
+{
+   std::swap(pRoot, rhs.pRoot);
+   std::swap(numElements, rhs.numElements);
+   pool.swap(rhs.pool);
+   this->swapCompare(rhs);
+}
+
+/**********************************************
+ * PAIRING HEAP :: INSERT
+ * Count a new node in and meld it with the root
+ **********************************************/
+template <class T, class Compare>
+typename pairing_heap <T, Compare> :: handle
+pairing_heap <T, Compare> :: insert(node * pNode)
+{
+   pRoot = link(pRoot, pNode);
+   numElements++;
+   return pNode;
+}
+
+/**********************************************
+ * PAIRING HEAP :: LINK
+ * Meld two trees, each a root with no siblings:
+ * the lesser root becomes the leftmost child of
+ * the other, which is returned. Ties keep the lhs
+ * on top.
+ **********************************************/
+template <class T, class Compare>
+typename pairing_heap <T, Compare> :: node *
+pairing_heap <T, Compare> :: link(node * pLHS, node * pRHS)
+{
+   if (!pLHS)
+      return pRHS;
+   if (!pRHS)
+      return pLHS;
+   if (this->comp()(pLHS->value, pRHS->value))
+      std::swap(pLHS, pRHS);
+
+   pRHS->pSibling = pLHS->pChild;
+   if (pLHS->pChild)
+      pLHS->pChild->pPrev = pRHS;
+   pRHS->pPrev = pLHS;
+   pLHS->pChild = pRHS;
+   return pLHS;
+}
+
+/**********************************************
+ * PAIRING HEAP :: LINK CHILDREN
+ * Meld a list of siblings into one tree in two
+ * passes: link them in pairs from the left, then
+ * fold the pairs into one from the right
+ **********************************************/
+template <class T, class Compare>
+typename pairing_heap <T, Compare> :: node *
+pairing_heap <T, Compare> :: linkChildren(node * pFirst)
+{
+   if (!pFirst)
+      return nullptr;
+   pFirst->pPrev = nullptr;
+   if (!pFirst->pSibling)
+      return pFirst;
+
+   // first pass: left to right, two at a time
+   assert(pairs.empty());
+   while (pFirst)
+   {
+      node * pLHS = pFirst;
+      node * pRHS = pFirst->pSibling;
+      pFirst = pRHS ? pRHS->pSibling : nullptr;
+      pLHS->pSibling = pLHS->pPrev = nullptr;
+      if (pRHS)
+         pRHS->pSibling = pRHS->pPrev = nullptr;
+      pairs.push_back(link(pLHS, pRHS));
+   }
+
+   // second pass: right to left, into the last pair
+   node * pTree = pairs.back();
+   pairs.pop_back();
+   while (!pairs.empty())
+   {
+      pTree = link(pairs.back(), pTree);
+      pairs.pop_back();
+   }
+   return pTree;
+}
+
+/**********************************************
+ * PAIRING HEAP :: CUT
+ * Unhook a node, and the subtree under it, from
+ * its parent or the sibling to its left
+ **********************************************/
+template <class T, class Compare>
+void pairing_heap <T, Compare> :: cut(node * pNode)
+{
+   assert(pNode != pRoot && pNode->pPrev);
+   if (pNode->pPrev->pChild == pNode)
+      pNode->pPrev->pChild = pNode->pSibling;
+   else
+      pNode->pPrev->pSibling = pNode->pSibling;
+   if (pNode->pSibling)
+      pNode->pSibling->pPrev = pNode->pPrev;
+   pNode->pSibling = pNode->pPrev = nullptr;
+}
+
+/**********************************************
+ * PAIRING HEAP :: RAISE
+ * A node's item went up. Its subtree is still in
+ * order, but the node may now beat its parent, which
+ * is only found by walking its left siblings. So
+ * rather than look, cut the subtree loose and meld
+ * it with the root.
+ **********************************************/
+template <class T, class Compare>
+void pairing_heap <T, Compare> :: raise(node * pNode)
+{
+   if (pNode == pRoot)
+      return;
+   cut(pNode);
+   pRoot = link(pRoot, pNode);
+}
+
+} // namespace custom
@@ -12,6 +12,11 @@
  *
  *    This will contain the class definition of:
  *        priority_queue          : A class that represents a Priority Queue
+ *        compare_by              : Order items by a key
+ *        layout_flat             : Nodes stored level by level
+ *        layout_blocked          : Nodes stored a subtree per block
+ *        track_none              : Record nothing when items move
+ *        wide_priority_queue     : A priority queue a cache line wide
  * Author
  *    Joel Jossie, Gergo Medveczky
  ************************************************************************/
@@ -19,33 +24,383 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>      // for uintptr_t
+#include <algorithm>    // for std::sort and std::nth_element
+#include <functional>   // for std::less
+#include <iterator>     // for std::distance
+#include <type_traits>  // for std::is_empty
 #include "vector.h"
+#include "simd_child.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>  // for _mm_prefetch
+#endif
+
+// how many levels below the children it compares percolating down
+// prefetches: 1 for the grandchildren, 2 for the level below those,
+// 0 for none. Deeper pays off only once the heap is far beyond cache
+#ifndef PQUEUE_PREFETCH_LEVELS
+#define PQUEUE_PREFETCH_LEVELS 1
+#endif
+
+// below this many bytes of items the heap stays in cache, and the
+// prefetches are pure overhead
+#ifndef PQUEUE_PREFETCH_MIN_BYTES
+#define PQUEUE_PREFETCH_MIN_BYTES (1 << 20)
+#endif
 
 class TestPQueue;    // forward declaration for unit test class
+class BenchPQueue;   // forward declaration for the benchmarks
 
 namespace custom
 {
 
+/*************************************************
+ * COMPARE HOLDER
+ * Hold the comparator. A stateless comparator such
+ * as std::less is an empty base so it takes no space.
+ *************************************************/
+template <class Compare,
+          bool isEmpty = std::is_empty<Compare>::value && !std::is_final<Compare>::value>
+class compare_holder : private Compare
+{
+public:
+   compare_holder() = default;
+   compare_holder(const Compare & compare) : Compare(compare) {}
+   const Compare & comp() const { return *this;                }
+   void swapCompare(compare_holder &) {}
+};
+
+template <class Compare>
+class compare_holder <Compare, false>
+{
+public:
+   compare_holder() : compare() {}
+   compare_holder(const Compare & compare) : compare(compare) {}
+   const Compare & comp() const { return compare;              }
+   void swapCompare(compare_holder & rhs) { std::swap(compare, rhs.compare); }
+private:
+   Compare compare;
+};
+
+/*************************************************
+ * COMPARE BY
+ * Order items by a key: KeyCompare applied to
+ * KeyOf()(item). KeyOf runs twice per comparison;
+ * keyed_priority_queue runs it once per item.
+ *************************************************/
+template <class KeyOf, class KeyCompare = std::less<void> >
+struct compare_by
+{
+   template <class T>
+   bool operator()(const T & lhs, const T & rhs) const
+   {
+      return KeyCompare()(KeyOf()(lhs), KeyOf()(rhs));
+   }
+};
+
+/*************************************************
+ * POP STRATEGIES
+ * How pop() restores the heap once the top is gone.
+ *   pop_top_down  : put the last item in the root and
+ *                   percolate it down, two or more
+ *                   comparisons per level
+ *   pop_bottom_up : walk the path of biggest children
+ *                   to a leaf, then percolate the last
+ *                   item up from there (Wegener). About
+ *                   one comparison per level in a binary
+ *                   heap: best when Compare is expensive
+ *************************************************/
+struct pop_top_down  {};
+struct pop_bottom_up {};
+
+/*************************************************
+ * LAYOUTS
+ * Where each node of the tree sits in the container.
+ * Either way the root is heap index 1, a child always
+ * comes after its parent, and the children of a node
+ * sit next to each other, so only the navigation and
+ * the storage differ. The tree also says where the
+ * num-th node in heap order sits (indexOf) and the
+ * one before an index (indexPrevious), since the
+ * heap indices need not be 1 .. size() with no gaps.
+ *   layout_flat    : level by level. The children of
+ *                    node i start at Arity*(i-1)+2
+ *   layout_blocked : a binary heap cut into blocks of
+ *                    BlockBytes (B-heap). See below
+ *************************************************/
+struct layout_flat
+{
+   template <class T, size_t Arity>
+   struct tree
+   {
+      typedef custom::vector<T> storage;
+      static const bool isLevelOrder = true;
+      static size_t indexParent(size_t indexHeap)     { return (indexHeap - 2) / Arity + 1; }
+      static size_t indexFirstChild(size_t indexHeap) { return Arity * (indexHeap - 1) + 2; }
+      static size_t indexLastParent(size_t indexBack) { return indexParent(indexBack);      }
+      static size_t indexOf(size_t num)               { return num;                         }
+      static size_t indexPrevious(size_t indexHeap)   { return indexHeap - 1;               }
+
+      // the nodes fill 1 .. size(), item i in container[i - 1]
+      static T &       at(storage & items, size_t indexHeap)       { return items[indexHeap - 1]; }
+      static const T & at(const storage & items, size_t indexHeap) { return items[indexHeap - 1]; }
+      static size_t    indexBack(const storage & items)            { return items.size();         }
+   };
+};
+
+/*************************************************
+ * LAYOUT BLOCKED
+ * On a heap of many GB, each level of a flat binary
+ * heap lands on a different cache line and, past the
+ * first dozen levels, a different page. Instead,
+ * each block of BlockBytes holds two sibling subtrees,
+ * so a path stays in one block for several levels:
+ * the height of those subtrees. The bottom nodes of a
+ * block each have their own child block, holding their
+ * two children as its roots.
+ * A block is 2^height slots, aligned to BlockBytes and
+ * padded to exactly BlockBytes, so it never straddles
+ * two lines or pages. The subtrees take 2^height - 2
+ * of the slots, and the heap index is the slot number:
+ * slots 0 and 1 of every block are empty, except that
+ * the root of the heap sits in slot 1 of the first.
+ * BlockBytes of 64 keeps subtrees in a cache line, and
+ * 4096 in a page. Binary heaps only.
+ *************************************************/
+template <size_t BlockBytes = 64>
+struct layout_blocked
+{
+   template <class T, size_t Arity>
+   struct tree
+   {
+      static_assert(Arity == 2, "the blocked layout is a binary heap");
+      static_assert(4 * sizeof(T) <= BlockBytes, "a block holds two subtrees and its padding");
+
+      // the tallest pair of subtrees whose 2^height slots fit in a block
+      static constexpr size_t heightOf()
+      {
+         size_t height = 2;
+         while ((size_t(2) << height) <= BlockBytes / sizeof(T))
+            height++;
+         return height;
+      }
+      static const size_t height    = heightOf();
+      static const size_t numSlots  = size_t(1) << height;         // slots per block
+      static const size_t numBlock  = numSlots - 2;                // nodes per block
+      static const size_t numBottom = size_t(1) << (height - 1);   // bottom nodes per block
+
+      static const bool isLevelOrder = false;
+
+      // Within a block, the slots are numbered as a complete binary tree
+      // whose root is missing: 2 and 3 are the roots of the two subtrees,
+      // the children of n are 2n and 2n+1, and numBottom and up are the
+      // bottom nodes. Block b is heap indices b * numSlots and up.
+      static size_t indexParent(size_t indexHeap)
+      {
+         size_t block = indexHeap >> height;
+         size_t node  = indexHeap & (numSlots - 1);
+         if (node >= 4)
+            return (block << height) + node / 2;
+         if (block == 0)
+            return 1;
+         size_t blockAbove = (block - 1) >> (height - 1);
+         size_t bottom     = (block - 1) & (numBottom - 1);
+         return (blockAbove << height) + numBottom + bottom;
+      }
+      static size_t indexFirstChild(size_t indexHeap)
+      {
+         if (indexHeap == 1)
+            return 2;
+         size_t block = indexHeap >> height;
+         size_t node  = indexHeap & (numSlots - 1);
+         if (node < numBottom)
+            return (block << height) + 2 * node;
+         return ((block * numBottom + 1 + node - numBottom) << height) + 2;
+      }
+
+      // No node past the parent of the last one has children, unless
+      // the last one is a root of its block: then any node in the
+      // block before may
+      static size_t indexLastParent(size_t indexBack)
+      {
+         if (indexBack <= 3)
+            return 1;
+         size_t node = indexBack & (numSlots - 1);
+         return node >= 4 ? indexParent(indexBack) : (indexBack | (numSlots - 1)) - numSlots;
+      }
+
+      // the num-th node in heap order, and the one before an index
+      static size_t indexOf(size_t num)
+      {
+         if (num <= 1)
+            return num;
+         return ((num - 2) / numBlock << height) + (num - 2) % numBlock + 2;
+      }
+      static size_t indexPrevious(size_t indexHeap)
+      {
+         if (indexHeap <= 2)
+            return indexHeap - 1;
+         return (indexHeap & (numSlots - 1)) == 2 ? indexHeap - 3 : indexHeap - 1;
+      }
+
+      /**********************************************
+       * STORAGE
+       * The nodes in heap order, like a vector, kept
+       * in aligned blocks of numSlots. operator[] and
+       * the bulk operations count the nodes in heap
+       * order, as in vector; at() takes a heap index.
+       * A popped item stays where it was until it is
+       * overwritten, as in vector.
+       **********************************************/
+      class storage
+      {
+         struct alignas(BlockBytes) block
+         {
+            T nodes[numSlots];
+         };
+         static_assert(sizeof(block) == BlockBytes, "a block is padded to exactly BlockBytes");
+
+      public:
+         storage() : numElements(0), indexLast(0) {}
+         storage(const storage & rhs) = default;
+         storage(storage && rhs) : blocks(std::move(rhs.blocks)), numElements(rhs.numElements),
+                                   indexLast(rhs.indexLast)
+         {
+            rhs.numElements = 0;
+            rhs.indexLast   = 0;
+         }
+         explicit storage(const custom::vector<T> & rhs) : numElements(0), indexLast(0)
+         {
+            reserve(rhs.size());
+            for (size_t i = 0; i < rhs.size(); i++)
+               push_back(rhs[i]);
+         }
+         explicit storage(custom::vector<T> && rhs) : numElements(0), indexLast(0)
+         {
+            reserve(rhs.size());
+            for (size_t i = 0; i < rhs.size(); i++)
+               push_back(std::move(rhs[i]));
+            rhs.clear();
+         }
+         storage & operator = (const storage & rhs) = default;
+         storage & operator = (storage && rhs)
+         {
+            blocks      = std::move(rhs.blocks);
+            numElements = rhs.numElements;
+            indexLast   = rhs.indexLast;
+            rhs.numElements = 0;
+            rhs.indexLast   = 0;
+            return *this;
+         }
+
+         T &       at(size_t indexHeap)       { return blocks[indexHeap >> height].nodes[indexHeap & (numSlots - 1)]; }
+         const T & at(size_t indexHeap) const { return blocks[indexHeap >> height].nodes[indexHeap & (numSlots - 1)]; }
+         T &       operator [] (size_t index)       { return at(indexOf(index + 1)); }
+         const T & operator [] (size_t index) const { return at(indexOf(index + 1)); }
+         const T & front() const { return at(1); }
+
+         void push_back(const T & t) { grow(); at(indexLast) = t;            }
+         void push_back(T && t)      { grow(); at(indexLast) = std::move(t); }
+         template <class ... Args>
+         void emplace_back(Args && ... args)
+         {
+            grow();
+            at(indexLast) = T(std::forward<Args>(args)...);
+         }
+         void reserve(size_t num) { if (num) blocks.reserve((indexOf(num) >> height) + 1); }
+         void pop_back()
+         {
+            if (numElements == 0)
+               return;
+            numElements--;
+            indexLast = indexPrevious(indexLast);
+         }
+         void clear() { numElements = 0; indexLast = 0; }
+
+         size_t size()      const { return numElements;      }
+         bool   empty()     const { return numElements == 0; }
+         size_t capacity()  const { return blocks.capacity() ? blocks.capacity() * numBlock + 1 : 0; }
+         size_t indexBack() const { return indexLast;        }
+
+      private:
+         // make room for one more node at the end, skipping the padding
+         void grow()
+         {
+            indexLast += (indexLast & (numSlots - 1)) == numSlots - 1 ? 3 : 1;
+            numElements++;
+            if ((indexLast >> height) == blocks.size())
+               blocks.push_back(block());
+         }
+
+         custom::vector<block> blocks;
+         size_t numElements;
+         size_t indexLast;    // heap index of the last node, 0 when empty
+      };
+
+      static T &       at(storage & items, size_t indexHeap)       { return items.at(indexHeap); }
+      static const T & at(const storage & items, size_t indexHeap) { return items.at(indexHeap); }
+      static size_t    indexBack(const storage & items)            { return items.indexBack();   }
+   };
+};
+
+/*************************************************
+ * TRACK NONE
+ * Every time a sift moves an item, the heap calls
+ * placed() with the item and its new heap index,
+ * and push() calls it for the new item. A queue that
+ * keeps a table of where its items sit, such as
+ * indexed_priority_queue, records them there. The
+ * bulk operations, which rebuild the heap, do not
+ * report moves, so a tracking queue must not use
+ * them. By default nothing is recorded, and the
+ * calls compile away.
+ *************************************************/
+struct track_none
+{
+   template <class T>
+   void placed(const T &, size_t) {}
+};
+
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+class indexed_priority_queue;
+
 /*************************************************
  * P QUEUE
- * Create a priority queue.
+ * Create a priority queue. The top is the item for
+ * which Compare holds against every other item: the
+ * largest with std::less, the smallest with std::greater.
+ * Each node has Arity children. A wider node makes a
+ * shallower tree, and its children share a cache line.
  *************************************************/
-template<class T>
-class priority_queue
+template<class T, class Compare = std::less<T>, size_t Arity = 2,
+         class PopStrategy = pop_top_down, class Layout = layout_flat,
+         class Track = track_none>
+class priority_queue : private compare_holder<Compare>, private Track
 {
+   static_assert(Arity >= 2, "a heap node needs at least two children");
+
    friend class ::TestPQueue; // give the unit test class access to the privates
-   template <class TT>
-   friend void swap(priority_queue<TT>& lhs, priority_queue<TT>& rhs);
+   friend class ::BenchPQueue;
+   template <class TT, class CC, size_t AA, class PP, class LL, class KK>
+   friend class priority_queue;
+   template <class TT, class CC, size_t AA, class PP, class LL>
+   friend class indexed_priority_queue;
+   template <class TT, class CC, size_t AA, class PP, class LL, class KK>
+   friend void swap(priority_queue<TT, CC, AA, PP, LL, KK>& lhs, priority_queue<TT, CC, AA, PP, LL, KK>& rhs);
 public:
 
    //
    // construct
    //
    priority_queue() = default;
-   priority_queue(const priority_queue &  rhs) : container(rhs.container)            {}
-   priority_queue(priority_queue && rhs)       : container(std::move(rhs.container)) {}
+   explicit priority_queue(const Compare & compare) : compare_holder<Compare>(compare) {}
+   priority_queue(const priority_queue &  rhs) : compare_holder<Compare>(rhs), Track(rhs), container(rhs.container) {}
+   priority_queue(priority_queue && rhs)       : compare_holder<Compare>(rhs), Track(std::move(rhs)),
+                                                 container(std::move(rhs.container)) {}
    template <class Iterator>
-   priority_queue(Iterator first, Iterator last) 
+   priority_queue(Iterator first, Iterator last, const Compare & compare = Compare()) :
+      compare_holder<Compare>(compare)
    {
       container.reserve(last - first);
       auto it = first;
@@ -54,9 +409,12 @@ public:
          container.push_back(*it);
          it++;
       }
+      heapify();
    }
-   explicit priority_queue (custom::vector<T> && rhs) : container(rhs) {}
-   explicit priority_queue (custom::vector<T> &  rhs) : container(rhs) {}
+   explicit priority_queue (custom::vector<T> && rhs, const Compare & compare = Compare()) :
+      compare_holder<Compare>(compare), container(std::move(rhs)) { heapify(); }
+   explicit priority_queue (custom::vector<T> &  rhs, const Compare & compare = Compare()) :
+      compare_holder<Compare>(compare), container(rhs)            { heapify(); }
   ~priority_queue()                                                    {}
 
    //
@@ -69,26 +427,104 @@ public:
    //
    void  push(const T& t);
    void  push(T&& t);     
+   template <class ... Args>
+   void  emplace(Args && ... args);
+   template <class Iterator>
+   void  push_range(Iterator first, Iterator last);
+   void  push_range(custom::vector<T> && items);
+   void  merge(priority_queue && rhs);
 
    //
    // Remove
    //
    void  pop(); 
+   T     pop_value();
+   bool  try_pop(T & t);
+   template <class OutputIterator>
+   OutputIterator pop_n(size_t num, OutputIterator out);
+   template <class Predicate>
+   size_t erase_if(Predicate pred);
+   template <class Predicate>
+   size_t retain_if(Predicate pred);
+
+   //
+   // Combined
+   //
+   T     replace_top(const T & t);
+   T     replace_top(T && t);
+   T     push_pop(const T & t);
+   T     push_pop(T && t);
 
    //
    // Status
    //
    size_t size() const { return container.size();  }
    bool empty()  const { return container.empty(); }
+
+   //
+   // Observers
+   //
+   Compare value_comp() const { return this->comp(); }
    
 private:
 
    bool percolateDown(size_t indexHeap);      // fix heap from index down. This is a heap index!
+   bool percolateUp(size_t indexHeap);        // fix heap from index up.   This is a heap index!
+   void percolateDownToLeaf(size_t indexHeap);  // percolate down an item from the bottom
+   void prefetchBelow(size_t indexHeap);      // start loading the descendants of an index
+   void heapify();                            // turn the whole container into a heap
+   void repairAppended(size_t numOld);        // fix heap after items were appended
+   void heapifyAppended(size_t numOld);
+   void reserveAppend(size_t numNew);         // room for numNew more items
+
+   // a batch at least 1/bulkRatio the size of the heap is cheaper to
+   // append and rebuild than to percolate up one item at a time. The
+   // crossover benchmark puts the break-even between 1/1024 and 1/4096
+   static const size_t bulkRatio = 1024;
 
-   custom::vector<T> container;
+   // pop_n selects when it takes at least 1/selectRatio of the items,
+   // and otherwise pops them one at a time. The drain benchmark puts
+   // the break-even between 1/16 and 1/32, for strings and for ints
+   static const size_t selectRatio = 16;
 
-   T & containerAt(size_t indexQueue) {
-      return container[indexQueue - 1];
+   void popRoot(pop_top_down);                // remove the root, at least two items
+   void popRoot(pop_bottom_up);
+
+   // navigate the tree. These are heap indices, the root is 1
+   typedef typename Layout::template tree<T, Arity> tree;
+   static size_t indexParent(size_t indexHeap)     { return tree::indexParent(indexHeap);     }
+   static size_t indexFirstChild(size_t indexHeap) { return tree::indexFirstChild(indexHeap); }
+   size_t indexBiggestChild(size_t indexHeap);  // zero if it has no children
+
+   // how indexBiggestChild searches the children
+   struct search_scalar     {};  // a branch per child
+   struct search_branchless {};  // a conditional move per child, for small plain T
+   struct search_vector     {};  // all at once, see simd_child.h
+   static const bool isSmallPlain = std::is_trivially_copyable<T>::value && sizeof(T) <= 16;
+   typedef typename std::conditional<simd_child<T, Compare, Arity>::isEnabled, search_vector,
+           typename std::conditional<isSmallPlain,                             search_branchless,
+                                                                               search_scalar>::type>::type search;
+   size_t indexBiggestChild(size_t indexFirst, size_t indexLast, search_scalar);
+   size_t indexBiggestChild(size_t indexFirst, size_t indexLast, search_branchless);
+   size_t indexBiggestChild(size_t indexFirst, size_t indexLast, search_vector);
+
+   // does the item at indexLHS belong below the item at indexRHS?
+   bool isLess(size_t indexLHS, size_t indexRHS)
+   {
+      return this->comp()(containerAt(indexLHS), containerAt(indexRHS));
+   }
+
+   typename tree::storage container;
+
+   T &       containerAt(size_t indexHeap)       { return tree::at(container, indexHeap); }
+   const T & containerAt(size_t indexHeap) const { return tree::at(container, indexHeap); }
+   size_t    indexBack() const                   { return tree::indexBack(container);     }
+
+   // move an item into a heap index, and tell Track where it went
+   void place(size_t indexHeap, T && t)
+   {
+      containerAt(indexHeap) = std::move(t);
+      this->placed(containerAt(indexHeap), indexHeap);
    }
 
 };
@@ -97,8 +533,8 @@ private:
  * P QUEUE :: TOP
  * Get the maximum item from the heap: the top item.
  ***********************************************/
-template <class T>
-const T & priority_queue <T> :: top() const
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+const T & priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: top() const
 {
    if(container.empty())
       throw "std:out_of_range";
@@ -109,74 +545,630 @@ const T & priority_queue <T> :: top() const
  * P QUEUE :: POP
  * Delete the top item from the heap.
  **********************************************/
-template <class T>
-void priority_queue <T> :: pop()
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: pop()
 {
-   if(size() > 0)
-   {
-      std::swap(containerAt(1), containerAt(size()));
+   if (size() > 1)
+      popRoot(PopStrategy());
+   else
       container.pop_back();
-      percolateDown(1);
+}
+
+/**********************************************
+ * P QUEUE :: POP VALUE
+ * Move the top item out and delete it from the
+ * heap: no copy of the item is made.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+T priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: pop_value()
+{
+   if (container.empty())
+      throw "std:out_of_range";
+   T t(std::move(containerAt(1)));
+   pop();
+   return t;
+}
+
+/**********************************************
+ * P QUEUE :: TRY POP
+ * Move the top item into t and delete it from the
+ * heap. Return FALSE, leaving t alone, when empty.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+bool priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: try_pop(T & t)
+{
+   if (container.empty())
+      return false;
+   t = std::move(containerAt(1));
+   pop();
+   return true;
+}
+
+/**********************************************
+ * P QUEUE :: POP N
+ * Move the top num items out, in priority order,
+ * and delete them from the heap.
+ * A few items come off cheapest a pop at a time.
+ * A big share of the heap is cheaper to select:
+ * gather the top num at the front of the container,
+ * sort only those, and rebuild the heap from the
+ * rest, O(n + num log num) rather than num log n.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+template <class OutputIterator>
+OutputIterator priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: pop_n(size_t num, OutputIterator out)
+{
+   if (num > size())
+      num = size();
+   if (num == 0)
+      return out;
+
+   // the blocked layout has no run of items to select from
+   if (num * selectRatio < size() || !tree::isLevelOrder)
+   {
+      for (size_t i = 0; i < num; i++)
+         *out++ = pop_value();
+      return out;
    }
+
+   // order the items so the ones that belong on top come first
+   const Compare & compare = this->comp();
+   auto isAbove = [&compare](const T & lhs, const T & rhs) { return compare(rhs, lhs); };
+   T * pBegin = &container[0];
+   T * pEnd   = pBegin + size();
+   if (num < size())
+      std::nth_element(pBegin, pBegin + num, pEnd, isAbove);
+   std::sort(pBegin, pBegin + num, isAbove);
+   for (size_t i = 0; i < num; i++)
+      *out++ = std::move(container[i]);
+
+   size_t numKept = size() - num;
+   for (size_t i = 0; i < numKept; i++)
+      container[i] = std::move(container[i + num]);
+   while (size() > numKept)
+      container.pop_back();
+   heapify();
+   return out;
+}
+
+/**********************************************
+ * P QUEUE :: ERASE IF
+ * Delete every item for which pred holds, and
+ * return how many there were. Slide the kept items
+ * to the front in one pass, calling pred once per
+ * item in container order, then rebuild the heap
+ * bottom-up. O(n) however many go.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+template <class Predicate>
+size_t priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: erase_if(Predicate pred)
+{
+   size_t numKept = 0;
+   for (size_t i = 0; i < container.size(); i++)
+      if (!pred(container[i]))
+      {
+         if (numKept != i)
+            container[numKept] = std::move(container[i]);
+         numKept++;
+      }
+
+   size_t numRemoved = size() - numKept;
+   if (numRemoved == 0)
+      return 0;
+   while (size() > numKept)
+      container.pop_back();
+   heapify();
+   return numRemoved;
+}
+
+/**********************************************
+ * P QUEUE :: RETAIN IF
+ * Keep only the items for which pred holds, and
+ * return how many were deleted
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+template <class Predicate>
+size_t priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: retain_if(Predicate pred)
+{
+   return erase_if([&pred](const T & t) { return !pred(t); });
+}
+
+/**********************************************
+ * P QUEUE :: REPLACE TOP
+ * Delete the top item and add t in one repair:
+ * overwrite the root and percolate it down once.
+ * Return the item that was on top.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+T priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: replace_top(const T & t)
+{
+   return replace_top(T(t));
+}
+
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+T priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: replace_top(T && t)
+{
+   if (container.empty())
+      throw "std:out_of_range";
+   T tTop(std::move(containerAt(1)));
+   place(1, std::move(t));
+   percolateDown(1);
+   return tTop;
+}
+
+/**********************************************
+ * P QUEUE :: PUSH POP
+ * Add t and then delete the top item, returning it.
+ * When t would be the new top, hand it straight back
+ * without touching the heap.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+T priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: push_pop(const T & t)
+{
+   if (container.empty() || !this->comp()(t, containerAt(1)))
+      return t;
+   return replace_top(T(t));
+}
+
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+T priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: push_pop(T && t)
+{
+   if (container.empty() || !this->comp()(t, containerAt(1)))
+      return std::move(t);
+   return replace_top(std::move(t));
+}
+
+/**********************************************
+ * P QUEUE :: POP ROOT (top down)
+ * Move the last item into the root, rather than
+ * swapping the two, and percolate it down.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: popRoot(pop_top_down)
+{
+   place(1, std::move(containerAt(indexBack())));
+   container.pop_back();
+   percolateDown(1);
+}
+
+/**********************************************
+ * P QUEUE :: POP ROOT (bottom up)
+ * The last item almost always belongs near the
+ * bottom, so drop it in the root and percolate it
+ * down the bottom-up way.
+ **********************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: popRoot(pop_bottom_up)
+{
+   place(1, std::move(containerAt(indexBack())));
+   container.pop_back();
+   percolateDownToLeaf(1);
 }
 
 /*****************************************
  * P QUEUE :: PUSH
  * Add a new element to the heap, reallocating as necessary
  ****************************************/
-template <class T>
-void priority_queue <T> :: push(const T & t)
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: push(const T & t)
 {
    container.push_back(t);
-   auto parentIndex = container.size() / 2;
-   while(parentIndex && percolateDown(parentIndex))
-      parentIndex /= 2;
+   this->placed(containerAt(indexBack()), indexBack());
+   percolateUp(indexBack());
 }
 
-template <class T>
-void priority_queue <T> :: push(T && t)
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: push(T && t)
 {
    container.push_back(std::move(t));
-   auto parentIndex = container.size() / 2;
-   while(parentIndex && percolateDown(parentIndex))
-      parentIndex /= 2;
+   this->placed(containerAt(indexBack()), indexBack());
+   percolateUp(indexBack());
+}
+
+/*****************************************
+ * P QUEUE :: EMPLACE
+ * Build a new element in place at the end of the
+ * heap, then percolate it up.
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+template <class ... Args>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: emplace(Args && ... args)
+{
+   container.emplace_back(std::forward<Args>(args)...);
+   this->placed(containerAt(indexBack()), indexBack());
+   percolateUp(indexBack());
+}
+
+/*****************************************
+ * P QUEUE :: PUSH RANGE
+ * Add a batch of elements to the heap, growing
+ * the buffer at most once
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+template <class Iterator>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: push_range(Iterator first, Iterator last)
+{
+   size_t numOld = size();
+   reserveAppend(std::distance(first, last));
+   for (auto it = first; it != last; ++it)
+      container.push_back(*it);
+   repairAppended(numOld);
+}
+
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: push_range(custom::vector<T> && items)
+{
+   size_t numOld = size();
+   reserveAppend(items.size());
+   for (size_t i = 0; i < items.size(); i++)
+      container.push_back(std::move(items[i]));
+   items.clear();
+   repairAppended(numOld);
+}
+
+/*****************************************
+ * P QUEUE :: MERGE
+ * Move every item of rhs into this heap, leaving
+ * rhs empty. Keep whichever buffer is bigger and
+ * append the smaller one to it, so only the smaller
+ * heap is moved. Both heaps must order their items
+ * the same way.
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: merge(priority_queue && rhs)
+{
+   if (&rhs == this || rhs.empty())
+      return;
+
+   // rhs is already a heap: steal it and append ours instead
+   if (rhs.size() > size())
+      std::swap(container, rhs.container);
+
+   size_t numOld = size();
+   reserveAppend(rhs.size());
+   for (size_t i = 0; i < rhs.size(); i++)
+      container.push_back(std::move(rhs.container[i]));
+   rhs.container.clear();
+   repairAppended(numOld);
+}
+
+/*****************************************
+ * P QUEUE :: RESERVE APPEND
+ * Make room for numNew more items, at least
+ * doubling so a stream of batches stays amortized
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: reserveAppend(size_t numNew)
+{
+   size_t numNeeded = size() + numNew;
+   if (numNeeded > container.capacity())
+      container.reserve(numNeeded > container.capacity() * 2 ?
+                        numNeeded : container.capacity() * 2);
+}
+
+/*****************************************
+ * P QUEUE :: REPAIR APPENDED
+ * Items numOld+1 .. size() were appended to a heap.
+ * A small batch is percolated up one item at a time;
+ * a big one is cheaper to rebuild.
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: repairAppended(size_t numOld)
+{
+   size_t numNew = size() - numOld;
+   if (numNew * bulkRatio >= numOld)
+      heapifyAppended(numOld);
+   else
+      for (size_t num = numOld + 1; num <= size(); num++)
+         percolateUp(tree::indexOf(num));
+}
+
+/*****************************************
+ * P QUEUE :: HEAPIFY APPENDED
+ * Items numOld+1 .. size() were appended to a heap.
+ * Only their ancestors can be out of order, and the
+ * ancestors on each level form one run of indices.
+ * Percolate each run down, bottom level first, the
+ * way heapify() does for the whole tree. Without
+ * levels, as in the blocked layout, rebuild it all.
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: heapifyAppended(size_t numOld)
+{
+   if (size() <= numOld)
+      return;
+   if (numOld == 0 || !tree::isLevelOrder)
+   {
+      heapify();
+      return;
+   }
+
+   size_t indexLow  = indexParent(numOld + 1);
+   size_t indexHigh = indexParent(size());
+   for (;;)
+   {
+      for (size_t indexHeap = indexHigh; indexHeap >= indexLow; indexHeap--)
+         percolateDown(indexHeap);
+      if (indexLow == 1)
+         break;
+      indexLow  = indexParent(indexLow);
+      indexHigh = indexParent(indexHigh);
+   }
 }
 
 /************************************************
  * P QUEUE :: PERCOLATE DOWN
  * The item at the passed index may be out of heap
  * order. Take care of that little detail!
+ * Rather than swapping at every level, lift the item
+ * out once, move each bigger child up into the hole,
+ * and drop the item into the final hole.
  * Return TRUE if anything changed.
  ************************************************/
-template <class T>
-bool priority_queue <T> :: percolateDown(size_t indexHeap)
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+bool priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: percolateDown(size_t indexHeap)
 {
-   auto indexLeft = indexHeap * 2;
-   auto indexRight = indexLeft + 1;
-   size_t indexBigger;
+   size_t indexBigger = indexBiggestChild(indexHeap);
 
-   if (indexRight <= size() && containerAt(indexLeft) < containerAt(indexRight))
-      indexBigger = indexRight;
-   else
-      indexBigger = indexLeft;
+   // nothing to do if the item is already in heap order
+   if (!indexBigger || !isLess(indexHeap, indexBigger))
+      return false;
+
+   T value(std::move(containerAt(indexHeap)));
+   size_t indexHole = indexHeap;
+   do
+   {
+      place(indexHole, std::move(containerAt(indexBigger)));
+      indexHole = indexBigger;
+      prefetchBelow(indexHole);
+      indexBigger = indexBiggestChild(indexHole);
+   }
+   while (indexBigger && this->comp()(value, containerAt(indexBigger)));
+
+   place(indexHole, std::move(value));
+   return true;
+}
 
-   if(indexBigger <= size() && containerAt(indexHeap) < containerAt(indexBigger))
+/************************************************
+ * P QUEUE :: PERCOLATE DOWN TO LEAF
+ * Percolate down an item that most likely belongs
+ * near the bottom (Wegener). Move the biggest child
+ * up at each level until the hole reaches a leaf,
+ * which costs no comparison against the item, then
+ * percolate the item back up, no higher than where
+ * it started.
+ ************************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: percolateDownToLeaf(size_t indexHeap)
+{
+   size_t indexChild = indexBiggestChild(indexHeap);
+   if (!indexChild)
+      return;
+
+   T value(std::move(containerAt(indexHeap)));
+   size_t indexHole = indexHeap;
+   for (; indexChild; indexChild = indexBiggestChild(indexHole))
    {
-      std::swap(containerAt(indexHeap), containerAt(indexBigger));
-      percolateDown(indexBigger);
-      return true;
+      place(indexHole, std::move(containerAt(indexChild)));
+      indexHole = indexChild;
+      prefetchBelow(indexHole);
    }
-   return false;
+
+   while (indexHole > indexHeap && this->comp()(containerAt(indexParent(indexHole)), value))
+   {
+      size_t indexAbove = indexParent(indexHole);
+      place(indexHole, std::move(containerAt(indexAbove)));
+      indexHole = indexAbove;
+   }
+   place(indexHole, std::move(value));
 }
 
+/************************************************
+ * P QUEUE :: PREFETCH BELOW
+ * On a heap far bigger than the cache, every level
+ * of a percolate down waits on memory. Ask for the
+ * descendants PQUEUE_PREFETCH_LEVELS below the
+ * children of the index now, so they are on their
+ * way by the time the hole gets there. In the flat
+ * layout, the descendants on one level sit next to
+ * each other, so this is one cache line or a few in
+ * a row.
+ * The lines are capped at one per line of each of
+ * the Arity child groups below the children: a
+ * level wider than that falls back to the level
+ * above it. A heap small enough to stay in cache
+ * fetches nothing.
+ * In the blocked layout only siblings sit together:
+ * cousins may be in different blocks. Finding each
+ * set of grandchildren there costs more than the
+ * prefetch saves, and the block already holds the
+ * next few levels of the path, so fetch nothing.
+ ************************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: prefetchBelow(size_t indexHeap)
+{
+#if PQUEUE_PREFETCH_LEVELS > 0
+   if (!tree::isLevelOrder || size() < PQUEUE_PREFETCH_MIN_BYTES / sizeof(T))
+      return;
+
+   const uintptr_t cacheLine = 64;
+   const size_t linesPerGroup = (Arity * sizeof(T) + cacheLine - 1) / cacheLine;
+   const size_t maxBytes = Arity * linesPerGroup * cacheLine;
+   size_t indexFirst = indexFirstChild(indexHeap);
+   size_t num = Arity;
+   for (int level = 0; level < PQUEUE_PREFETCH_LEVELS; level++)
+   {
+      if (level && num * Arity * sizeof(T) > maxBytes)
+         break;
+      indexFirst = indexFirstChild(indexFirst);
+      num *= Arity;
+   }
+   if (indexFirst > size())
+      return;
+
+   size_t indexLast = std::min(indexFirst + num - 1, size());
+   uintptr_t address = reinterpret_cast<uintptr_t>(&containerAt(indexFirst)) & ~(cacheLine - 1);
+   uintptr_t end     = reinterpret_cast<uintptr_t>(&containerAt(indexLast) + 1);
+   for (; address < end; address += cacheLine)
+   {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+      _mm_prefetch(reinterpret_cast<const char *>(address), _MM_HINT_T0);
+#elif defined(__GNUC__)
+      __builtin_prefetch(reinterpret_cast<const void *>(address));
+#endif
+   }
+#else
+   (void)indexHeap;
+#endif // PQUEUE_PREFETCH_LEVELS
+}
+
+/************************************************
+ * P QUEUE :: INDEX BIGGEST CHILD
+ * Find the child that belongs on top of its siblings.
+ * Return zero if the node is a leaf.
+ ************************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+size_t priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: indexBiggestChild(size_t indexHeap)
+{
+   size_t indexEnd = indexBack();
+   size_t indexFirst = indexFirstChild(indexHeap);
+   if (indexFirst > indexEnd)
+      return 0;
+
+   size_t indexLast = indexFirst + Arity - 1 <= indexEnd ? indexFirst + Arity - 1 : indexEnd;
+   return indexBiggestChild(indexFirst, indexLast, search());
+}
+
+/************************************************
+ * P QUEUE :: INDEX BIGGEST CHILD (scalar)
+ * Compare the children one after another, only as
+ * many as there are
+ ************************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+size_t priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: indexBiggestChild(size_t indexFirst, size_t indexLast,
+                                                                           search_scalar)
+{
+   size_t indexBigger = indexFirst;
+   for (size_t indexChild = indexFirst + 1; indexChild <= indexLast; indexChild++)
+      if (isLess(indexBigger, indexChild))
+         indexBigger = indexChild;
+   return indexBigger;
+}
+
+/************************************************
+ * P QUEUE :: INDEX BIGGEST CHILD (branchless)
+ * On random keys, which child wins is a coin toss,
+ * and a branch on it is mispredicted half the time.
+ * Instead, carry a copy of the biggest child so far
+ * and select both it and its index without a branch,
+ * so no child is loaded twice. Only the last parent
+ * can have fewer than Arity children; it gets the
+ * scalar loop.
+ ************************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+size_t priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: indexBiggestChild(size_t indexFirst, size_t indexLast,
+                                                                           search_branchless)
+{
+   if (indexLast - indexFirst + 1 < Arity)
+      return indexBiggestChild(indexFirst, indexLast, search_scalar());
+   size_t indexBigger = indexFirst;
+   T bigger = containerAt(indexFirst);
+   for (size_t offset = 1; offset < Arity; offset++)
+   {
+      size_t indexChild = indexFirst + offset;
+      T child = containerAt(indexChild);
+      bool isBigger = this->comp()(bigger, child);
+      indexBigger = isBigger ? indexChild : indexBigger;
+      bigger      = isBigger ? child      : bigger;
+   }
+   return indexBigger;
+}
+
+/************************************************
+ * P QUEUE :: INDEX BIGGEST CHILD (vector)
+ * Compare a full set of children all at once. The
+ * last parent may have fewer, so it gets the scalar
+ * loop.
+ ************************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+size_t priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: indexBiggestChild(size_t indexFirst, size_t indexLast,
+                                                                           search_vector)
+{
+   if (indexLast - indexFirst + 1 < Arity)
+      return indexBiggestChild(indexFirst, indexLast, search_scalar());
+   return indexFirst + simd_child<T, Compare, Arity>::best(&containerAt(indexFirst));
+}
+
+/************************************************
+ * P QUEUE :: PERCOLATE UP
+ * The item at the passed index may be bigger than
+ * its parent. Compare only against the parent on
+ * each level, moving each smaller parent down into
+ * the hole, and stop as soon as the parent wins.
+ * Return TRUE if anything changed.
+ ************************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+bool priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: percolateUp(size_t indexHeap)
+{
+   // nothing to do if the item is already in heap order
+   if (indexHeap <= 1 || !isLess(indexParent(indexHeap), indexHeap))
+      return false;
+
+   T value(std::move(containerAt(indexHeap)));
+   size_t indexHole = indexHeap;
+   do
+   {
+      size_t indexAbove = indexParent(indexHole);
+      place(indexHole, std::move(containerAt(indexAbove)));
+      indexHole = indexAbove;
+   }
+   while (indexHole > 1 && this->comp()(containerAt(indexParent(indexHole)), value));
+
+   place(indexHole, std::move(value));
+   return true;
+}
+
+
+/************************************************
+ * P QUEUE :: HEAPIFY
+ * Build the heap bottom-up (Floyd): percolate down
+ * every parent, from the last one back to the root.
+ * This is O(n), where n pushes would be O(n log n).
+ ************************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+void priority_queue <T, Compare, Arity, PopStrategy, Layout, Track> :: heapify()
+{
+   if (size() < 2)
+      return;
+   for (size_t indexHeap = tree::indexLastParent(indexBack()); indexHeap >= 1;
+        indexHeap = tree::indexPrevious(indexHeap))
+      percolateDown(indexHeap);
+}
+
+
+/************************************************
+ * WIDE PRIORITY QUEUE
+ * A heap whose nodes have as many children as fit
+ * in a cache line: 16 for 4 byte keys, 8 for 8 byte
+ * keys. With int32, int64, float or double keys under
+ * std::less or std::greater, the biggest child is
+ * found with vector compares (see simd_child.h).
+ ************************************************/
+template <class T, class Compare = std::less<T> >
+using wide_priority_queue = priority_queue<T, Compare, (sizeof(T) <= 4 ? 16 : 8)>;
 
 /************************************************
  * SWAP
  * Swap the contents of two priority queues
  ************************************************/
-template <class T>
-inline void swap(custom::priority_queue <T>& lhs,
-                 custom::priority_queue <T>& rhs) { std::swap(lhs.container, rhs.container); }
+template <class T, class Compare, size_t Arity, class PopStrategy, class Layout, class Track>
+inline void swap(custom::priority_queue <T, Compare, Arity, PopStrategy, Layout, Track>& lhs,
+                 custom::priority_queue <T, Compare, Arity, PopStrategy, Layout, Track>& rhs)
+{
+   std::swap(lhs.container, rhs.container);
+   std::swap(static_cast<Track &>(lhs), static_cast<Track &>(rhs));
+   lhs.swapCompare(rhs);
+}
 
 };
 
@@ -0,0 +1,304 @@
+/***********************************************************************
+ * Header:
+ *    RADIX HEAP
+ * Summary:
+ *    A min heap for monotone keys: unsigned integers, or floating
+ *    point keys ordered by their bits. No key pushed may be smaller
+ *    than the last one taken off the top.
+ *
+ *    This will contain the class definition of:
+ *        radix_key               : A key as order-preserving unsigned bits
+ *        radix_heap              : A monotone min heap of buckets
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>      // for uint32_t and uint64_t
+#include <cstring>      // for std::memcpy
+#include <limits>       // for std::numeric_limits
+#include <type_traits>  // for std::is_unsigned
+#include "vector.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>     // for _BitScanReverse64
+#endif
+
+class TestRadixHeap;    // forward declaration for unit test class
+class BenchPQueue;      // forward declaration for the benchmarks
+
+namespace custom
+{
+
+/*************************************************
+ * RADIX KEY
+ * The unsigned bits of a key, in the same order as
+ * the key. Unsigned integers are their own bits.
+ *************************************************/
+template <class Key>
+struct radix_key
+{
+   static_assert(std::is_unsigned<Key>::value,
+                 "a radix_heap key is an unsigned integer, a float, or a double");
+   typedef Key bits;
+   static bits encode(Key key)  { return key;  }
+   static Key  decode(bits b)   { return b;    }
+};
+
+/*************************************************
+ * RADIX KEY : FLOATING POINT
+ * A float or double as bits. A positive number
+ * gets its sign bit set, so it sorts above every
+ * negative one; a negative number has all of its bits
+ * flipped, so a bigger magnitude sorts lower. -0
+ * is folded into +0 since the two compare equal. NaN
+ * has no place in the order.
+ *************************************************/
+template <class Key, class Bits>
+struct radix_key_float
+{
+   static_assert(sizeof(Key) == sizeof(Bits), "the bits must hold the key exactly");
+   typedef Bits bits;
+   static const Bits signBit = Bits(1) << (sizeof(Bits) * 8 - 1);
+
+   static bits encode(Key key)
+   {
+      key += Key(0);   // -0 + 0 is +0
+      Bits b;
+      std::memcpy(&b, &key, sizeof(b));
+      return (b & signBit) ? Bits(~b) : Bits(b | signBit);
+   }
+   static Key decode(bits b)
+   {
+      b = (b & signBit) ? Bits(b & ~signBit) : Bits(~b);
+      Key key;
+      std::memcpy(&key, &b, sizeof(key));
+      return key;
+   }
+};
+
+template <> struct radix_key <float>  : radix_key_float <float,  uint32_t> {};
+template <> struct radix_key <double> : radix_key_float <double, uint64_t> {};
+
+/*************************************************
+ * RADIX HEAP
+ * A radix heap (Ahuja, Mehlhorn, Orlin, Tarjan) for
+ * workloads whose minimum never goes down, such as
+ * Dijkstra's distances or simulated time. It keeps
+ * last, the smallest key it has handed out, and puts
+ * every item in the bucket of the highest bit where
+ * its key differs from last: bucket 0 holds the items
+ * equal to last, bucket b those that first differ at
+ * bit b-1. When bucket 0 runs dry, the first bucket
+ * with items has the next minimum. It becomes the new
+ * last, and the rest of that bucket spreads out into
+ * lower buckets. An item only ever moves down, so it
+ * moves at most once per bit of the key: push and pop
+ * are O(log C) amortized for keys of up to C, however
+ * many items are queued, and only refilling compares
+ * keys, to find the minimum of one bucket.
+ * Looking at the top may refill, so top() is not
+ * const. A key pushed must be no smaller than the key
+ * last seen on top, or push throws.
+ *************************************************/
+template <class Key, class Value>
+class radix_heap
+{
+   friend class ::TestRadixHeap; // give the unit test class access to the privates
+   friend class ::BenchPQueue;
+   typedef typename radix_key<Key>::bits bits;
+   static const size_t numBits = sizeof(bits) * 8;
+
+   // an item and its key, already in bits
+   struct entry
+   {
+      bits key;
+      Value value;
+   };
+
+public:
+
+   //
+   // construct
+   //
+   radix_heap() : last(0), numElements(0) {}
+
+   //
+   // Access
+   //
+   Key     top_key();
+   Value & top();
+
+   //
+   // Insert
+   //
+   void push(const Key & key, const Value & value);
+   void push(const Key & key, Value && value);
+
+   //
+   // Remove
+   //
+   void  pop();
+   Value pop_value();
+   void  clear();
+
+   //
+   // Status
+   //
+   size_t size()  const { return numElements;      }
+   bool   empty() const { return numElements == 0; }
+
+private:
+   size_t bucketOf(bits key) const;          // the bucket a key belongs in, for now
+   bits   checkKey(const Key & key) const;   // the key as bits, if it is not too small
+   void   refill();                          // make sure bucket 0 has the minimum
+
+   custom::vector<entry> buckets[numBits + 1];
+   bits   last;                              // no queued key is smaller
+   size_t numElements;
+};
+
+/************************************************
+ * RADIX HEAP :: TOP
+ * The smallest key, or the value that goes with it
+ ***********************************************/
+template <class Key, class Value>
+Key radix_heap <Key, Value> :: top_key()
+{
+   refill();
+   return radix_key<Key>::decode(last);
+}
+
+template <class Key, class Value>
+Value & radix_heap <Key, Value> :: top()
+{
+   refill();
+   return buckets[0].back().value;
+}
+
+/*****************************************
+ * RADIX HEAP :: PUSH
+ * Put the item straight into its bucket
+ ****************************************/
+template <class Key, class Value>
+void radix_heap <Key, Value> :: push(const Key & key, const Value & value)
+{
+   bits b = checkKey(key);
+   buckets[bucketOf(b)].push_back(entry{ b, value });
+   numElements++;
+}
+
+template <class Key, class Value>
+void radix_heap <Key, Value> :: push(const Key & key, Value && value)
+{
+   bits b = checkKey(key);
+   buckets[bucketOf(b)].push_back(entry{ b, std::move(value) });
+   numElements++;
+}
+
+/**********************************************
+ * RADIX HEAP :: POP
+ * Delete an item with the smallest key. Among
+ * equal keys, the last one in comes out first.
+ **********************************************/
+template <class Key, class Value>
+void radix_heap <Key, Value> :: pop()
+{
+   if (empty())
+      return;
+   refill();
+   buckets[0].pop_back();
+   numElements--;
+}
+
+template <class Key, class Value>
+Value radix_heap <Key, Value> :: pop_value()
+{
+   refill();
+   Value value(std::move(buckets[0].back().value));
+   buckets[0].pop_back();
+   numElements--;
+   return value;
+}
+
+/**********************************************
+ * RADIX HEAP :: CLEAR
+ * Drop every item, keeping the bucket buffers.
+ * Any key may be pushed again.
+ **********************************************/
+template <class Key, class Value>
+void radix_heap <Key, Value> :: clear()
+{
+   for (size_t i = 0; i <= numBits; i++)
+      buckets[i].clear();
+   last = 0;
+   numElements = 0;
+}
+
+/**********************************************
+ * RADIX HEAP :: BUCKET OF
+ * One more than the index of the highest bit where
+ * the key differs from last, or 0 if it does not
+ **********************************************/
+template <class Key, class Value>
+size_t radix_heap <Key, Value> :: bucketOf(bits key) const
+{
+   uint64_t differ = uint64_t(key ^ last);
+   if (!differ)
+      return 0;
+#ifdef _MSC_VER
+   unsigned long indexHigh;
+   _BitScanReverse64(&indexHigh, differ);
+   return size_t(indexHigh) + 1;
+#else
+   return size_t(64 - __builtin_clzll(differ));
+#endif
+}
+
+/**********************************************
+ * RADIX HEAP :: CHECK KEY
+ * A key smaller than last has no bucket
+ **********************************************/
+template <class Key, class Value>
+typename radix_heap <Key, Value> :: bits
+radix_heap <Key, Value> :: checkKey(const Key & key) const
+{
+   bits b = radix_key<Key>::encode(key);
+   if (b < last)
+      throw "std:invalid_argument";
+   return b;
+}
+
+/**********************************************
+ * RADIX HEAP :: REFILL
+ * When bucket 0 is empty, find the first bucket
+ * with items. Its smallest key becomes last, and
+ * every item in it moves to a lower bucket: the
+ * items share the bits above that bucket's bit with
+ * last, and so now differ from it further down.
+ **********************************************/
+template <class Key, class Value>
+void radix_heap <Key, Value> :: refill()
+{
+   if (empty())
+      throw "std:out_of_range";
+   if (!buckets[0].empty())
+      return;
+
+   size_t indexBucket = 1;
+   while (buckets[indexBucket].empty())
+      indexBucket++;
+
+   custom::vector<entry> & bucket = buckets[indexBucket];
+   bits keyMin = bucket[0].key;
+   for (size_t i = 1; i < bucket.size(); i++)
+      keyMin = bucket[i].key < keyMin ? bucket[i].key : keyMin;
+
+   last = keyMin;
+   for (size_t i = 0; i < bucket.size(); i++)
+      buckets[bucketOf(bucket[i].key)].push_back(std::move(bucket[i]));
+   bucket.clear();
+}
+
+} // namespace custom
@@ -0,0 +1,310 @@
+/***********************************************************************
+ * Header:
+ *    SIMD CHILD
+ * Summary:
+ *    Find the biggest of a node's children with vector compares, for
+ *    wide heaps of int32, int64, float, or double keys
+ *
+ *    This will contain the class definition of:
+ *        simd_lanes              : Vector operations on one key type
+ *        simd_child              : The biggest of Arity children
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#include <cstddef>      // for size_t
+#include <cstdint>      // for int32_t and int64_t
+#include <functional>   // for std::less and std::greater
+#include <type_traits>  // for std::is_same
+
+// the instruction set is chosen when compiling: AVX2, then SSE4.2,
+// and otherwise none, so the heap falls back to scalar compares.
+// MSVC never defines __SSE4_2__, but /arch:AVX implies it
+#if defined(__AVX2__)
+#define PQUEUE_SIMD_AVX2
+#elif defined(__SSE4_2__) || (defined(_MSC_VER) && defined(__AVX__))
+#define PQUEUE_SIMD_SSE4
+#endif
+
+#if defined(PQUEUE_SIMD_AVX2) || defined(PQUEUE_SIMD_SSE4)
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>     // for _BitScanForward
+#endif
+#endif
+
+namespace custom
+{
+
+/*************************************************
+ * SIMD KEY
+ * The key type whose vector operations serve T:
+ * any signed 32 or 64 bit integer, float or double.
+ * void when there are none.
+ *************************************************/
+template <class T>
+struct simd_key
+{
+   typedef typename std::conditional<std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 4, int32_t,
+           typename std::conditional<std::is_integral<T>::value && std::is_signed<T>::value && sizeof(T) == 8, int64_t,
+           typename std::conditional<std::is_same<T, float>::value || std::is_same<T, double>::value, T,
+           void>::type>::type>::type type;
+};
+
+/*************************************************
+ * SIMD LANES
+ * Vector operations on one key type: load, lane by
+ * lane max and min, a bitmask of the equal lanes, and
+ * spread, which leaves the max or min of all lanes in
+ * every lane. Only the types the compiled instruction
+ * set handles are specialized.
+ *************************************************/
+template <class Key>
+struct simd_lanes
+{
+   static const bool isEnabled = false;
+   static const size_t width = 1;
+};
+
+#if defined(PQUEUE_SIMD_AVX2)
+
+template <>
+struct simd_lanes <int32_t>
+{
+   static const bool isEnabled = true;
+   static const size_t width = 8;
+   typedef __m256i vec;
+   static vec load(const void * p)       { return _mm256_loadu_si256(static_cast<const __m256i *>(p)); }
+   static vec max(vec lhs, vec rhs)      { return _mm256_max_epi32(lhs, rhs);                          }
+   static vec min(vec lhs, vec rhs)      { return _mm256_min_epi32(lhs, rhs);                          }
+   static unsigned equal(vec lhs, vec rhs)
+   {
+      return unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(lhs, rhs))));
+   }
+   template <class Op>
+   static vec spread(vec v, Op op)
+   {
+      v = op(v, _mm256_permute2x128_si256(v, v, 1));
+      v = op(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+      return op(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+   }
+};
+
+// AVX2 has no 64 bit max or min, so blend on a compare
+template <>
+struct simd_lanes <int64_t>
+{
+   static const bool isEnabled = true;
+   static const size_t width = 4;
+   typedef __m256i vec;
+   static vec load(const void * p)       { return _mm256_loadu_si256(static_cast<const __m256i *>(p)); }
+   static vec max(vec lhs, vec rhs)      { return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(rhs, lhs)); }
+   static vec min(vec lhs, vec rhs)      { return _mm256_blendv_epi8(lhs, rhs, _mm256_cmpgt_epi64(lhs, rhs)); }
+   static unsigned equal(vec lhs, vec rhs)
+   {
+      return unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(lhs, rhs))));
+   }
+   template <class Op>
+   static vec spread(vec v, Op op)
+   {
+      v = op(v, _mm256_permute2x128_si256(v, v, 1));
+      return op(v, _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+   }
+};
+
+template <>
+struct simd_lanes <float>
+{
+   static const bool isEnabled = true;
+   static const size_t width = 8;
+   typedef __m256 vec;
+   static vec load(const void * p)       { return _mm256_loadu_ps(static_cast<const float *>(p)); }
+   static vec max(vec lhs, vec rhs)      { return _mm256_max_ps(lhs, rhs);                        }
+   static vec min(vec lhs, vec rhs)      { return _mm256_min_ps(lhs, rhs);                        }
+   static unsigned equal(vec lhs, vec rhs)
+   {
+      return unsigned(_mm256_movemask_ps(_mm256_cmp_ps(lhs, rhs, _CMP_EQ_OQ)));
+   }
+   template <class Op>
+   static vec spread(vec v, Op op)
+   {
+      v = op(v, _mm256_permute2f128_ps(v, v, 1));
+      v = op(v, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+      return op(v, _mm256_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+   }
+};
+
+template <>
+struct simd_lanes <double>
+{
+   static const bool isEnabled = true;
+   static const size_t width = 4;
+   typedef __m256d vec;
+   static vec load(const void * p)       { return _mm256_loadu_pd(static_cast<const double *>(p)); }
+   static vec max(vec lhs, vec rhs)      { return _mm256_max_pd(lhs, rhs);                         }
+   static vec min(vec lhs, vec rhs)      { return _mm256_min_pd(lhs, rhs);                         }
+   static unsigned equal(vec lhs, vec rhs)
+   {
+      return unsigned(_mm256_movemask_pd(_mm256_cmp_pd(lhs, rhs, _CMP_EQ_OQ)));
+   }
+   template <class Op>
+   static vec spread(vec v, Op op)
+   {
+      v = op(v, _mm256_permute2f128_pd(v, v, 1));
+      return op(v, _mm256_shuffle_pd(v, v, 0x5));
+   }
+};
+
+#elif defined(PQUEUE_SIMD_SSE4)
+
+template <>
+struct simd_lanes <int32_t>
+{
+   static const bool isEnabled = true;
+   static const size_t width = 4;
+   typedef __m128i vec;
+   static vec load(const void * p)       { return _mm_loadu_si128(static_cast<const __m128i *>(p)); }
+   static vec max(vec lhs, vec rhs)      { return _mm_max_epi32(lhs, rhs);                          }
+   static vec min(vec lhs, vec rhs)      { return _mm_min_epi32(lhs, rhs);                          }
+   static unsigned equal(vec lhs, vec rhs)
+   {
+      return unsigned(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(lhs, rhs))));
+   }
+   template <class Op>
+   static vec spread(vec v, Op op)
+   {
+      v = op(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+      return op(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+   }
+};
+
+// the 64 bit compare is SSE4.2; there is no 64 bit max or min
+template <>
+struct simd_lanes <int64_t>
+{
+   static const bool isEnabled = true;
+   static const size_t width = 2;
+   typedef __m128i vec;
+   static vec load(const void * p)       { return _mm_loadu_si128(static_cast<const __m128i *>(p)); }
+   static vec max(vec lhs, vec rhs)      { return _mm_blendv_epi8(lhs, rhs, _mm_cmpgt_epi64(rhs, lhs)); }
+   static vec min(vec lhs, vec rhs)      { return _mm_blendv_epi8(lhs, rhs, _mm_cmpgt_epi64(lhs, rhs)); }
+   static unsigned equal(vec lhs, vec rhs)
+   {
+      return unsigned(_mm_movemask_pd(_mm_castsi128_pd(_mm_cmpeq_epi64(lhs, rhs))));
+   }
+   template <class Op>
+   static vec spread(vec v, Op op)
+   {
+      return op(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+   }
+};
+
+template <>
+struct simd_lanes <float>
+{
+   static const bool isEnabled = true;
+   static const size_t width = 4;
+   typedef __m128 vec;
+   static vec load(const void * p)       { return _mm_loadu_ps(static_cast<const float *>(p)); }
+   static vec max(vec lhs, vec rhs)      { return _mm_max_ps(lhs, rhs);                        }
+   static vec min(vec lhs, vec rhs)      { return _mm_min_ps(lhs, rhs);                        }
+   static unsigned equal(vec lhs, vec rhs)
+   {
+      return unsigned(_mm_movemask_ps(_mm_cmpeq_ps(lhs, rhs)));
+   }
+   template <class Op>
+   static vec spread(vec v, Op op)
+   {
+      v = op(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 0, 3, 2)));
+      return op(v, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)));
+   }
+};
+
+template <>
+struct simd_lanes <double>
+{
+   static const bool isEnabled = true;
+   static const size_t width = 2;
+   typedef __m128d vec;
+   static vec load(const void * p)       { return _mm_loadu_pd(static_cast<const double *>(p)); }
+   static vec max(vec lhs, vec rhs)      { return _mm_max_pd(lhs, rhs);                         }
+   static vec min(vec lhs, vec rhs)      { return _mm_min_pd(lhs, rhs);                         }
+   static unsigned equal(vec lhs, vec rhs)
+   {
+      return unsigned(_mm_movemask_pd(_mm_cmpeq_pd(lhs, rhs)));
+   }
+   template <class Op>
+   static vec spread(vec v, Op op)
+   {
+      return op(v, _mm_shuffle_pd(v, v, 1));
+   }
+};
+
+#endif // PQUEUE_SIMD_AVX2, PQUEUE_SIMD_SSE4
+
+/*************************************************
+ * SIMD CHILD
+ * Find the biggest of the Arity children of a node,
+ * which sit next to each other in the container.
+ * Enabled for 8 or 16 children of a simd_key type
+ * under std::less or std::greater, when the compiled
+ * instruction set has the lanes for it. Any other
+ * comparator is opaque, so it gets the scalar loop.
+ * The first of several equal children wins, as in
+ * the scalar loop.
+ *************************************************/
+template <class T, class Compare, size_t Arity>
+class simd_child
+{
+   typedef typename simd_key<T>::type key;
+   typedef simd_lanes<key> lanes;
+   static const bool isMax = std::is_same<Compare, std::less<T> >::value;
+   static const bool isMin = std::is_same<Compare, std::greater<T> >::value;
+public:
+   static const bool isEnabled = lanes::isEnabled && (isMax || isMin) &&
+                                 (Arity == 8 || Arity == 16) && Arity % lanes::width == 0;
+
+   static size_t best(const T * children);
+};
+
+/************************************************
+ * SIMD CHILD :: BEST
+ * Reduce the children to their max (or min) in one
+ * vector, spread it to every lane, then find the
+ * first child equal to it. Return its offset.
+ ************************************************/
+template <class T, class Compare, size_t Arity>
+size_t simd_child <T, Compare, Arity> :: best(const T * children)
+{
+   typedef typename lanes::vec vec;
+   const size_t numVectors = Arity / lanes::width;
+   vec (*op)(vec, vec) = isMax ? &lanes::max : &lanes::min;
+
+   vec v[numVectors];
+   for (size_t i = 0; i < numVectors; i++)
+      v[i] = lanes::load(children + i * lanes::width);
+
+   vec bestAll = v[0];
+   for (size_t i = 1; i < numVectors; i++)
+      bestAll = op(bestAll, v[i]);
+   bestAll = lanes::spread(bestAll, op);
+
+   unsigned mask = 0;
+   for (size_t i = 0; i < numVectors; i++)
+      mask |= lanes::equal(v[i], bestAll) << (i * lanes::width);
+
+   // no child equals the best only when a NaN is in the way
+   if (!mask)
+      return 0;
+#ifdef _MSC_VER
+   unsigned long offset;
+   _BitScanForward(&offset, mask);
+   return offset;
+#else
+   return size_t(__builtin_ctz(mask));
+#endif
+}
+
+} // namespace custom
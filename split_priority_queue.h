@@ -0,0 +1,171 @@
+/***********************************************************************
+ * Header:
+ *    SPLIT PRIORITY QUEUE
+ * Summary:
+ *    A priority queue of keys, each with a payload stored apart from
+ *    the heap, so that sifting moves only small keys
+ *
+ *    This will contain the class definition of:
+ *        split_priority_queue    : A priority queue with split payloads
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>      // for uint32_t
+#include <functional>   // for std::less
+#include "priority_queue.h"
+#include "vector.h"
+
+class TestSplitPQueue;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * SPLIT ENTRY
+ * A key and the slot that holds its payload
+ *************************************************/
+template <class Key>
+struct split_entry
+{
+   Key key;
+   uint32_t slot;
+};
+
+/*************************************************
+ * SPLIT COMPARE
+ * Order entries by Compare on their keys
+ *************************************************/
+template <class Key, class Compare>
+class split_compare : private compare_holder<Compare>
+{
+public:
+   split_compare(const Compare & compare = Compare()) : compare_holder<Compare>(compare) {}
+   bool operator()(const split_entry<Key> & lhs, const split_entry<Key> & rhs) const
+   {
+      return this->comp()(lhs.key, rhs.key);
+   }
+};
+
+/*************************************************
+ * SPLIT PRIORITY QUEUE
+ * The heap holds only keys and 32-bit slot numbers,
+ * packed densely, and the payloads sit in a parallel
+ * array indexed by slot. Percolating compares and
+ * moves keys and slot numbers alone; a payload is
+ * written on push and read on pop, and stays put in
+ * between unless the payload array grows. Worth it
+ * when the payload is much bigger than the key.
+ * Slots of popped payloads are reused.
+ *************************************************/
+template<class Key, class Payload, class Compare = std::less<Key>, size_t Arity = 2,
+         class PopStrategy = pop_top_down>
+class split_priority_queue
+{
+   friend class ::TestSplitPQueue; // give the unit test class access to the privates
+public:
+
+   //
+   // construct
+   //
+   split_priority_queue() = default;
+   explicit split_priority_queue(const Compare & compare) :
+      heap(split_compare<Key, Compare>(compare)) {}
+
+   //
+   // Access
+   //
+   const Key &     top_key() const { return heap.top().key;                }
+   const Payload & top()     const { return payloads[heap.top().slot];     }
+
+   //
+   // Insert
+   //
+   void push(const Key & key, const Payload & payload);
+   void push(const Key & key, Payload && payload);
+
+   //
+   // Remove
+   //
+   void    pop();
+   Payload pop_value();
+
+   //
+   // Status
+   //
+   size_t size()  const { return heap.size();  }
+   bool   empty() const { return heap.empty(); }
+
+private:
+   uint32_t newSlot();                       // a free slot, recycled if possible
+
+   priority_queue <split_entry<Key>, split_compare<Key, Compare>, Arity, PopStrategy> heap;
+   custom::vector<Payload>  payloads;        // indexed by slot
+   custom::vector<uint32_t> freeSlots;       // slots ready to be reused
+};
+
+/*****************************************
+ * SPLIT P QUEUE :: PUSH
+ * Store the payload in a slot, then sift only
+ * the key and the slot number
+ ****************************************/
+template <class Key, class Payload, class Compare, size_t Arity, class PopStrategy>
+void split_priority_queue <Key, Payload, Compare, Arity, PopStrategy> :: push(const Key & key, const Payload & payload)
+{
+   uint32_t slot = newSlot();
+   payloads[slot] = payload;
+   heap.push(split_entry<Key>{ key, slot });
+}
+
+template <class Key, class Payload, class Compare, size_t Arity, class PopStrategy>
+void split_priority_queue <Key, Payload, Compare, Arity, PopStrategy> :: push(const Key & key, Payload && payload)
+{
+   uint32_t slot = newSlot();
+   payloads[slot] = std::move(payload);
+   heap.push(split_entry<Key>{ key, slot });
+}
+
+/**********************************************
+ * SPLIT P QUEUE :: POP
+ * Delete the top key, and release its payload
+ * and its slot
+ **********************************************/
+template <class Key, class Payload, class Compare, size_t Arity, class PopStrategy>
+void split_priority_queue <Key, Payload, Compare, Arity, PopStrategy> :: pop()
+{
+   if (heap.empty())
+      return;
+   uint32_t slot = heap.top().slot;
+   payloads[slot] = Payload();
+   freeSlots.push_back(slot);
+   heap.pop();
+}
+
+template <class Key, class Payload, class Compare, size_t Arity, class PopStrategy>
+Payload split_priority_queue <Key, Payload, Compare, Arity, PopStrategy> :: pop_value()
+{
+   uint32_t slot = heap.pop_value().slot;
+   freeSlots.push_back(slot);
+   return std::move(payloads[slot]);
+}
+
+/**********************************************
+ * SPLIT P QUEUE :: NEW SLOT
+ * Reuse a freed slot, or add one to the payloads
+ **********************************************/
+template <class Key, class Payload, class Compare, size_t Arity, class PopStrategy>
+uint32_t split_priority_queue <Key, Payload, Compare, Arity, PopStrategy> :: newSlot()
+{
+   if (!freeSlots.empty())
+   {
+      uint32_t slot = freeSlots.back();
+      freeSlots.pop_back();
+      return slot;
+   }
+   payloads.emplace_back();
+   return uint32_t(payloads.size() - 1);
+}
+
+} // namespace custom
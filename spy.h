@@ -36,7 +36,7 @@ public:
    int * p;
    
    // default constructor: allocate a spot and assign to zero
-   Spy() : p(nullptr) { counters[DEFAULT]++; }
+   Spy() noexcept : p(nullptr) { counters[DEFAULT]++; }
    
    // non-default constructor: allocate a spot and assign to the value
    Spy(int value) : p(nullptr)
@@ -0,0 +1,280 @@
+/***********************************************************************
+ * Header:
+ *    STABLE PRIORITY QUEUE
+ * Summary:
+ *    A priority queue that hands out items of equal priority in
+ *    the order they were pushed: first in, first out
+ *
+ *    This will contain the class definition of:
+ *        stable_priority_queue   : A priority queue with FIFO ties
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#include <cstdint>      // for uint32_t and uint64_t
+#include <cstring>      // for std::memcpy
+#include <functional>   // for std::less and std::greater
+#include <type_traits>  // for std::is_integral
+#include <utility>      // for std::declval
+#include "priority_queue.h"
+
+class TestStablePQueue;    // forward declaration for unit test class
+
+namespace custom
+{
+
+/*************************************************
+ * STABLE ENTRY
+ * An item and the sequence number it was pushed with
+ *************************************************/
+template <class T>
+struct stable_entry
+{
+   T value;
+   uint64_t sequence;
+};
+
+/*************************************************
+ * STABLE COMPARE
+ * Order entries by Compare, then the older entry
+ * first: the (priority, sequence) wrapper clients
+ * write by hand. A tie costs a second call to
+ * Compare before the sequence numbers settle it.
+ *************************************************/
+template <class T, class Compare>
+class stable_compare : private compare_holder<Compare>
+{
+public:
+   stable_compare(const Compare & compare = Compare()) : compare_holder<Compare>(compare) {}
+   bool operator()(const stable_entry<T> & lhs, const stable_entry<T> & rhs) const
+   {
+      if (this->comp()(lhs.value, rhs.value))
+         return true;
+      if (this->comp()(rhs.value, lhs.value))
+         return false;
+      return lhs.sequence > rhs.sequence;
+   }
+};
+
+/*************************************************
+ * STABLE TRAITS
+ * How an item and its sequence number are stored
+ * in the heap. Any T is kept in a stable_entry with
+ * a 64-bit sequence number.
+ *************************************************/
+template <class T, class Compare, class Enable = void>
+struct stable_traits
+{
+   typedef stable_entry<T>               entry;
+   typedef stable_compare<T, Compare>    compare;
+   typedef const T &                     const_reference;
+   static const uint64_t sequenceMax = UINT64_MAX;
+
+   static compare makeCompare(const Compare & c)     { return compare(c);                      }
+   static entry pack(const T & t, uint64_t sequence) { return entry{ t, sequence };            }
+   static entry pack(T && t, uint64_t sequence)      { return entry{ std::move(t), sequence }; }
+   static const T & value(const entry & e)           { return e.value;                         }
+   static T && value(entry && e)                     { return std::move(e.value);              }
+   static void resequence(entry & e, uint64_t sequence) { e.sequence = sequence;               }
+};
+
+/*************************************************
+ * STABLE TRAITS : packed
+ * For compare_by on an integer key of 32 bits or
+ * fewer, or a float key, under std::less or
+ * std::greater. Float keys must not be NaN.
+ * The key, mapped so that unsigned order matches
+ * KeyCompare, goes in the high half of one 64-bit
+ * word and the inverted 32-bit sequence number in
+ * the low half. A single integer comparison orders
+ * by key and then by age, and KeyOf runs once per
+ * push rather than twice per comparison.
+ *************************************************/
+template <class T, class Compare>
+struct stable_is_packable : std::false_type {};
+
+template <class T, class KeyOf, class KeyCompare>
+struct stable_is_packable <T, compare_by<KeyOf, KeyCompare> >
+{
+   typedef typename std::decay<decltype(KeyOf()(std::declval<const T &>()))>::type key_type;
+   static const bool value = ((std::is_integral<key_type>::value &&
+                               !std::is_same<key_type, bool>::value &&
+                               sizeof(key_type) <= sizeof(uint32_t)) ||
+                              std::is_same<key_type, float>::value) &&
+                             (std::is_same<KeyCompare, std::less<void> >::value ||
+                              std::is_same<KeyCompare, std::less<key_type> >::value ||
+                              std::is_same<KeyCompare, std::greater<void> >::value ||
+                              std::is_same<KeyCompare, std::greater<key_type> >::value);
+};
+
+template <class T>
+struct stable_packed_entry
+{
+   uint64_t order;   // key, then inverted sequence number
+   T value;
+};
+
+struct stable_packed_compare
+{
+   template <class T>
+   bool operator()(const stable_packed_entry<T> & lhs, const stable_packed_entry<T> & rhs) const
+   {
+      return lhs.order < rhs.order;
+   }
+};
+
+template <class T, class KeyOf, class KeyCompare>
+struct stable_traits <T, compare_by<KeyOf, KeyCompare>,
+                      typename std::enable_if<stable_is_packable<T, compare_by<KeyOf, KeyCompare> >::value>::type>
+{
+   typedef stable_packed_entry<T>   entry;
+   typedef stable_packed_compare    compare;
+   typedef const T &                const_reference;
+   static const uint64_t sequenceMax = UINT32_MAX;
+
+   // flip everything when the smallest key is on top
+   typedef typename stable_is_packable<T, compare_by<KeyOf, KeyCompare> >::key_type key_type;
+   static const uint32_t keyMask =
+      std::is_same<KeyCompare, std::greater<void> >::value ||
+      std::is_same<KeyCompare, std::greater<key_type> >::value ? 0xffffffffu : 0u;
+
+   // flip the sign bit so signed order becomes unsigned order
+   template <class Key>
+   static uint32_t keyBits(Key key)
+   {
+      return uint32_t(int64_t(key)) ^ (std::is_signed<Key>::value ? 0x80000000u : 0u);
+   }
+
+   // a float is sign and magnitude: flip every bit of a negative
+   // one so bigger magnitudes sort lower, and set the sign bit of
+   // a positive one. Adding zero turns -0 into +0, its equal
+   static uint32_t keyBits(float key)
+   {
+      uint32_t bits;
+      key += 0.0f;
+      std::memcpy(&bits, &key, sizeof(bits));
+      return bits & 0x80000000u ? ~bits : bits | 0x80000000u;
+   }
+
+   static compare makeCompare(const compare_by<KeyOf, KeyCompare> &) { return compare(); }
+   static uint64_t order(const T & t, uint64_t sequence)
+   {
+      uint32_t key = keyBits(key_type(KeyOf()(t))) ^ keyMask;
+      return (uint64_t(key) << 32) | uint32_t(~sequence);
+   }
+   static entry pack(const T & t, uint64_t sequence) { return entry{ order(t, sequence), t };            }
+   static entry pack(T && t, uint64_t sequence)      { return entry{ order(t, sequence), std::move(t) }; }
+   static const T & value(const entry & e)           { return e.value;                                  }
+   static T && value(entry && e)                     { return std::move(e.value);                       }
+   static void resequence(entry & e, uint64_t sequence)
+   {
+      e.order = (e.order & 0xffffffff00000000ull) | uint32_t(~sequence);
+   }
+};
+
+/*************************************************
+ * STABLE PRIORITY QUEUE
+ * A priority queue where items that tie under
+ * Compare come off the top in the order they were
+ * pushed. Every push is stamped with a rising
+ * sequence number that breaks ties.
+ * Only the packed mode, compare_by on a small
+ * integer or float key, is faster than a
+ * hand-written (priority, sequence) wrapper: one
+ * integer compare per step. Any other Compare runs
+ * as fast as that wrapper and no faster.
+ *************************************************/
+template<class T, class Compare = std::less<T>, size_t Arity = 2,
+         class PopStrategy = pop_top_down>
+class stable_priority_queue
+{
+   friend class ::TestStablePQueue; // give the unit test class access to the privates
+   typedef stable_traits<T, Compare> traits;
+   typedef typename traits::entry entry;
+public:
+   typedef typename traits::const_reference const_reference;
+
+   //
+   // construct
+   //
+   stable_priority_queue() : sequence(0) {}
+   explicit stable_priority_queue(const Compare & compare) :
+      heap(traits::makeCompare(compare)), sequence(0) {}
+
+   //
+   // Access
+   //
+   const_reference top() const { return traits::value(heap.top()); }
+
+   //
+   // Insert
+   //
+   void push(const T & t);
+   void push(T && t);
+   template <class ... Args>
+   void emplace(Args && ... args) { push(T(std::forward<Args>(args)...)); }
+
+   //
+   // Remove
+   //
+   void pop()                     { heap.pop(); }
+   T    pop_value()               { return traits::value(heap.pop_value()); }
+
+   //
+   // Status
+   //
+   size_t size()  const { return heap.size();  }
+   bool   empty() const { return heap.empty(); }
+
+private:
+   void resequence();             // renumber the entries from zero
+
+   priority_queue <entry, typename traits::compare, Arity, PopStrategy> heap;
+   uint64_t sequence;             // stamped on the next push
+};
+
+/*****************************************
+ * STABLE P QUEUE :: PUSH
+ * Stamp the item with the next sequence number,
+ * renumbering first if the numbers have run out
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+void stable_priority_queue <T, Compare, Arity, PopStrategy> :: push(const T & t)
+{
+   if (sequence == traits::sequenceMax)
+      resequence();
+   heap.push(traits::pack(t, sequence++));
+}
+
+template <class T, class Compare, size_t Arity, class PopStrategy>
+void stable_priority_queue <T, Compare, Arity, PopStrategy> :: push(T && t)
+{
+   if (sequence == traits::sequenceMax)
+      resequence();
+   heap.push(traits::pack(std::move(t), sequence++));
+}
+
+/*****************************************
+ * STABLE P QUEUE :: RESEQUENCE
+ * The sequence numbers ran out. Pop every entry,
+ * which gives them in priority order with ties
+ * oldest first, and number them again from zero in
+ * that order. Ties keep their order, and the next
+ * push is numbered after every entry in the heap.
+ ****************************************/
+template <class T, class Compare, size_t Arity, class PopStrategy>
+void stable_priority_queue <T, Compare, Arity, PopStrategy> :: resequence()
+{
+   custom::vector<entry> entries;
+   entries.reserve(heap.size());
+   while (!heap.empty())
+      entries.push_back(heap.pop_value());
+
+   for (sequence = 0; sequence < entries.size(); sequence++)
+      traits::resequence(entries[sequence], sequence);
+   heap.push_range(std::move(entries));
+}
+
+} // namespace custom
@@ -0,0 +1,417 @@
+/***********************************************************************
+ * Header:
+ *    TEST INDEXED PRIORITY QUEUE
+ * Summary:
+ *    Unit tests for the indexed priority queue
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "indexed_priority_queue.h"  // class under test
+#include "unitTest.h"                // unit test baseclass
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+
+class TestIPQueue : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Access
+      test_top_empty();
+      test_get_invalid();
+
+      // Insert
+      test_push_handles();
+      test_push_standard();
+
+      // Change
+      test_update_up();
+      test_update_down();
+      test_update_invalid();
+      test_update_blockedBottomUp();
+
+      // Remove
+      test_pop_standard();
+      test_pop_recycle();
+      test_erase_middle();
+      test_erase_last();
+      test_erase_twice();
+      test_erase_stale();
+
+      report("IPQueue");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::indexed_priority_queue <int> pq;
+      // verify
+      assertUnit(pq.empty());
+      assertUnit(pq.size() == 0);
+      assertUnit(pq.positions().size() == 0);
+      assertUnit(pq.freeSlots.size() == 0);
+   }  // teardown
+
+   /***************************************
+    * TOP and GET
+    ***************************************/
+
+   // top of an empty queue throws
+   void test_top_empty()
+   {  // setup
+      custom::indexed_priority_queue <int> pq;
+      // exercise
+      try
+      {
+         pq.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   // a handle that is not queued throws
+   void test_get_invalid()
+   {  // setup
+      custom::indexed_priority_queue <int> pq;
+      pq.push(5);
+      // exercise
+      try
+      {
+         pq.get(1);
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // every push gets its own handle, and the handle finds the item
+   void test_push_handles()
+   {  // setup
+      custom::indexed_priority_queue <int> pq;
+      // exercise
+      uint64_t h5 = pq.push(5);
+      uint64_t h9 = pq.push(9);
+      uint64_t h2 = pq.push(2);
+      // verify
+      assertUnit(h5 == 0);
+      assertUnit(h9 == 1);
+      assertUnit(h2 == 2);
+      assertUnit(pq.get(h5) == 5);
+      assertUnit(pq.get(h9) == 9);
+      assertUnit(pq.get(h2) == 2);
+      assertUnit(pq.top() == 9);
+      assertUnit(pq.top_handle() == h9);
+      assertUnit(isConsistent(pq));
+   }  // teardown
+
+   // the standard fixture, pushed in order
+   void test_push_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::indexed_priority_queue <int> pq;
+      // exercise
+      setupStandardFixture(pq);
+      // verify
+      assertUnit(pq.size() == 7);
+      assertUnit(pq.top() == 10);
+      assertUnit(isConsistent(pq));
+   }  // teardown
+
+   /***************************************
+    * UPDATE
+    ***************************************/
+
+   // raise a leaf above the root
+   void test_update_up()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::indexed_priority_queue <int> pq;
+      setupStandardFixture(pq);
+      uint64_t h3 = handleOf(pq, 3);
+      // exercise
+      pq.update(h3, 11);
+      // verify
+      assertUnit(pq.get(h3) == 11);
+      assertUnit(pq.top() == 11);
+      assertUnit(pq.top_handle() == h3);
+      assertUnit(isConsistent(pq));
+      assertUnit(popAll(pq) == std::string("11 10 9 8 7 5 4 "));
+   }  // teardown
+
+   // lower the root below every leaf
+   void test_update_down()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::indexed_priority_queue <int> pq;
+      setupStandardFixture(pq);
+      uint64_t h10 = handleOf(pq, 10);
+      // exercise
+      pq.update(h10, 1);
+      // verify
+      assertUnit(pq.get(h10) == 1);
+      assertUnit(pq.top() == 9);
+      assertUnit(isConsistent(pq));
+      assertUnit(popAll(pq) == std::string("9 8 7 5 4 3 1 "));
+   }  // teardown
+
+   // update a handle that was popped throws
+   void test_update_invalid()
+   {  // setup
+      custom::indexed_priority_queue <int> pq;
+      uint64_t h = pq.push(5);
+      pq.pop();
+      // exercise
+      try
+      {
+         pq.update(h, 6);
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("std:out_of_range"));
+      }
+      assertUnit(pq.empty());
+   }  // teardown
+
+   // the blocked layout and the bottom-up pop keep the table right
+   void test_update_blockedBottomUp()
+   {  // setup
+      custom::indexed_priority_queue <int, std::less<int>, 2, custom::pop_bottom_up,
+                                      custom::layout_blocked<64> > pq;
+      uint64_t handles[100];
+      for (int i = 0; i < 100; i++)
+         handles[i] = pq.push((i * 37) % 100);
+      // exercise
+      for (int i = 0; i < 100; i += 3)
+         pq.update(handles[i], (i * 37) % 100 + 200);
+      for (int i = 1; i < 100; i += 7)
+         pq.erase(handles[i]);
+      bool isConsistentAfterChange = isConsistent(pq);
+      for (int i = 0; i < 10; i++)
+         pq.pop();
+      // verify
+      assertUnit(isConsistentAfterChange);
+      assertUnit(isConsistent(pq));
+      assertUnit(pq.size() == 100 - 15 - 10);
+      assertUnit(pq.top() == 264);
+   }  // teardown
+
+   /***************************************
+    * POP and ERASE
+    ***************************************/
+
+   // pop hands the items out biggest first
+   void test_pop_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::indexed_priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // exercise
+      int value = pq.pop_value();
+      // verify
+      assertUnit(value == 10);
+      assertUnit(pq.size() == 6);
+      assertUnit(isConsistent(pq));
+      assertUnit(popAll(pq) == std::string("9 8 7 5 4 3 "));
+   }  // teardown
+
+   // a popped slot is recycled by the next push, under a new handle
+   void test_pop_recycle()
+   {  // setup
+      custom::indexed_priority_queue <int> pq;
+      pq.push(5);
+      uint64_t h9 = pq.push(9);
+      pq.pop();
+      // exercise
+      uint64_t h = pq.push(7);
+      // verify
+      assertUnit(h != h9);
+      assertUnit(uint32_t(h) == uint32_t(h9));
+      assertUnit(pq.contains(h));
+      assertUnit(!pq.contains(h9));
+      assertUnit(pq.positions().size() == 2);
+      assertUnit(pq.top() == 7);
+      assertUnit(isConsistent(pq));
+   }  // teardown
+
+   // erase an item in the middle of the heap
+   void test_erase_middle()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::indexed_priority_queue <int> pq;
+      setupStandardFixture(pq);
+      uint64_t h8 = handleOf(pq, 8);
+      // exercise
+      pq.erase(h8);
+      // verify
+      assertUnit(!pq.contains(h8));
+      assertUnit(pq.size() == 6);
+      assertUnit(isConsistent(pq));
+      assertUnit(popAll(pq) == std::string("10 9 7 5 4 3 "));
+   }  // teardown
+
+   // erase the last item in the container
+   void test_erase_last()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::indexed_priority_queue <int> pq;
+      setupStandardFixture(pq);
+      uint64_t h5 = handleOf(pq, 5);
+      // exercise
+      pq.erase(h5);
+      // verify
+      assertUnit(pq.size() == 6);
+      assertUnit(isConsistent(pq));
+      assertUnit(popAll(pq) == std::string("10 9 8 7 4 3 "));
+   }  // teardown
+
+   // erase the same handle twice throws the second time
+   void test_erase_twice()
+   {  // setup
+      custom::indexed_priority_queue <int> pq;
+      uint64_t h = pq.push(5);
+      pq.push(6);
+      pq.erase(h);
+      // exercise
+      try
+      {
+         pq.erase(h);
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("std:out_of_range"));
+      }
+      assertUnit(pq.size() == 1);
+      assertUnit(pq.top() == 6);
+   }  // teardown
+
+   // a handle whose slot went to a newer item names nothing
+   void test_erase_stale()
+   {  // setup
+      custom::indexed_priority_queue <int> pq;
+      uint64_t hOld = pq.push(5);
+      pq.push(6);
+      pq.erase(hOld);
+      uint64_t hNew = pq.push(7);
+      int numThrown = 0;
+      // exercise
+      try { pq.erase(hOld);     } catch (const char *) { numThrown++; }
+      try { pq.update(hOld, 1); } catch (const char *) { numThrown++; }
+      try { pq.get(hOld);       } catch (const char *) { numThrown++; }
+      // verify
+      assertUnit(numThrown == 3);
+      assertUnit(uint32_t(hNew) == uint32_t(hOld));
+      assertUnit(!pq.contains(hOld));
+      assertUnit(pq.get(hNew) == 7);
+      assertUnit(pq.size() == 2);
+      assertUnit(isConsistent(pq));
+   }  // teardown
+
+   /***************************************************
+    * SETUP STANDARD FIXTURE
+    *               10
+    *         8            9
+    *      4     3      7     5
+    ***************************************************/
+   void setupStandardFixture(custom::indexed_priority_queue <int> & pq)
+   {
+      for (int value : { 10, 8, 9, 4, 3, 7, 5 })
+         pq.push(value);
+   }
+
+   /***************************************************
+    * HANDLE OF
+    * The handle of the queued item with this value
+    ***************************************************/
+   uint64_t handleOf(custom::indexed_priority_queue <int> & pq, int value)
+   {
+      for (size_t indexHeap = 1; indexHeap <= pq.size(); indexHeap++)
+         if (pq.containerAt(indexHeap).value == value)
+            return pq.handleOf(pq.containerAt(indexHeap).slot);
+      return uint64_t(-1);
+   }
+
+   /***************************************************
+    * IS CONSISTENT
+    * The container is a heap, and the position table
+    * agrees with it in both directions
+    ***************************************************/
+   template <class PQ>
+   bool isConsistent(PQ & pq)
+   {
+      size_t numQueued = 0;
+      for (uint32_t slot = 0; slot < pq.positions().size(); slot++)
+         if (pq.positions()[slot])
+         {
+            numQueued++;
+            size_t indexHeap = pq.positions()[slot];
+            if (indexHeap > pq.indexBack() || pq.containerAt(indexHeap).slot != slot)
+               return false;
+            if (indexHeap > 1 && pq.isLess(pq.indexParent(indexHeap), indexHeap))
+               return false;
+         }
+      return numQueued == pq.size();
+   }
+
+   /***************************************************
+    * POP ALL
+    * Empty the queue, spelling out the items in order
+    ***************************************************/
+   std::string popAll(custom::indexed_priority_queue <int> & pq)
+   {
+      std::string values;
+      while (!pq.empty())
+      {
+         values += std::to_string(pq.top()) + " ";
+         pq.pop();
+      }
+      return values;
+   }
+};
+
+#endif // DEBUG
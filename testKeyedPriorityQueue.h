@@ -0,0 +1,196 @@
+/***********************************************************************
+ * Header:
+ *    TEST KEYED PRIORITY QUEUE
+ * Summary:
+ *    Unit tests for the keyed priority queue
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "keyed_priority_queue.h"  // class under test
+#include "unitTest.h"              // unit test baseclass
+
+#include <functional>
+#include <string>
+
+
+class TestKeyedPQueue : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_constructRange_standard();
+
+      // Insert
+      test_push_standard();
+      test_push_keyOnce();
+      test_push_compareBy();
+
+      // Remove
+      test_pop_greater();
+      test_popValue_standard();
+
+      report("KeyedPQ");
+   }
+
+   /***************************************************
+    * SCORE
+    * The key of a word: the sum of its letters, a = 1.
+    * Counts every call, like the Spy counts its moves.
+    ***************************************************/
+   struct Score
+   {
+      int operator()(const std::string & word) const
+      {
+         numCalls++;
+         int score = 0;
+         for (char letter : word)
+            score += letter - 'a' + 1;
+         return score;
+      }
+      static inline int numCalls = 0;
+   };
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::keyed_priority_queue <std::string, Score> pq;
+      // verify
+      assertUnit(pq.empty());
+      assertUnit(pq.size() == 0);
+   }  // teardown
+
+   // range constructor computes each key once
+   void test_constructRange_standard()
+   {  // setup
+      std::string words[] = { "cab", "a", "dog", "zz", "bee", "ox" };
+      Score::numCalls = 0;
+      // exercise
+      custom::keyed_priority_queue <std::string, Score> pq(words, words + 6);
+      // verify
+      assertUnit(Score::numCalls == 6);
+      assertUnit(pq.size() == 6);
+      assertUnit(pq.top() == std::string("zz"));
+      assertUnit(pq.top_key() == 52);
+      assertUnit(popAll(pq) == std::string("zz ox dog bee cab a "));
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push keeps the best score on top
+   void test_push_standard()
+   {  // setup
+      custom::keyed_priority_queue <std::string, Score> pq;
+      // exercise
+      for (const char * word : { "cab", "a", "dog", "zz", "bee", "ox" })
+         pq.push(std::string(word));
+      // verify
+      assertUnit(pq.size() == 6);
+      assertUnit(pq.top() == std::string("zz"));
+      assertUnit(popAll(pq) == std::string("zz ox dog bee cab a "));
+   }  // teardown
+
+   // pushing and draining n items computes n keys
+   void test_push_keyOnce()
+   {  // setup
+      custom::keyed_priority_queue <std::string, Score> pq;
+      Score::numCalls = 0;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         pq.push(wordOf(i));
+      while (!pq.empty())
+         pq.pop();
+      // verify
+      assertUnit(Score::numCalls == 100);
+   }  // teardown
+
+   // the same through compare_by computes two keys per comparison
+   void test_push_compareBy()
+   {  // setup
+      custom::priority_queue <std::string, custom::compare_by<Score> > pq;
+      Score::numCalls = 0;
+      // exercise
+      for (int i = 0; i < 100; i++)
+         pq.push(wordOf(i));
+      while (!pq.empty())
+         pq.pop();
+      // verify
+      assertUnit(Score::numCalls > 10 * 100);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // the smallest score first with std::greater
+   void test_pop_greater()
+   {  // setup
+      custom::keyed_priority_queue <std::string, Score, std::greater<int> > pq;
+      for (const char * word : { "cab", "a", "dog", "zz", "bee", "ox" })
+         pq.push(std::string(word));
+      // exercise
+      std::string words = popAll(pq);
+      // verify
+      assertUnit(words == std::string("a cab bee dog ox zz "));
+   }  // teardown
+
+   // pop_value moves the top item out
+   void test_popValue_standard()
+   {  // setup
+      custom::keyed_priority_queue <std::string, Score> pq;
+      pq.push(std::string("cab"));
+      pq.push(std::string("dog"));
+      // exercise
+      std::string word = pq.pop_value();
+      // verify
+      assertUnit(word == std::string("dog"));
+      assertUnit(pq.size() == 1);
+      assertUnit(pq.top() == std::string("cab"));
+   }  // teardown
+
+   /***************************************************
+    * WORD OF
+    * A different made-up word for every number
+    ***************************************************/
+   std::string wordOf(int i)
+   {
+      std::string word;
+      for (int n = (i * 7919) % 10007 + 1; n; n /= 26)
+         word += char('a' + n % 26);
+      return word;
+   }
+
+   /***************************************************
+    * POP ALL
+    * Empty the queue, spelling out the items in order
+    ***************************************************/
+   template <class PQ>
+   std::string popAll(PQ & pq)
+   {
+      std::string words;
+      while (!pq.empty())
+      {
+         words += pq.top() + " ";
+         pq.pop();
+      }
+      return words;
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,311 @@
+/***********************************************************************
+ * Header:
+ *    TEST LAZY PRIORITY QUEUE
+ * Summary:
+ *    Unit tests for the lazy priority queue
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "lazy_priority_queue.h"  // class under test
+#include "unitTest.h"             // unit test baseclass
+
+#include <cstdint>
+#include <string>
+
+
+class TestLazyPQueue : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_push_standard();
+
+      // Remove
+      test_pop_standard();
+      test_cancel_top();
+      test_cancel_buried();
+      test_cancel_thenPop();
+      test_cancel_popped();
+      test_cancel_twice();
+      test_cancel_recycled();
+      test_cancel_all();
+      test_cancel_compact();
+      test_maxDeadRatio_compact();
+
+      report("LazyPQ");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::lazy_priority_queue <int> pq;
+      // verify
+      assertUnit(pq.empty());
+      assertUnit(pq.size() == 0);
+      assertUnit(pq.numDead == 0);
+      assertUnit(pq.max_dead_ratio() == 0.5);
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // every push gets a handle that is live
+   void test_push_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::lazy_priority_queue <int> pq;
+      uint64_t handles[7];
+      // exercise
+      setupStandardFixture(pq, handles);
+      // verify
+      assertUnit(pq.size() == 7);
+      assertUnit(pq.top() == 10);
+      for (uint64_t h : handles)
+         assertUnit(pq.contains(h));
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop takes the top and retires its handle
+   void test_pop_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::lazy_priority_queue <int> pq;
+      uint64_t handles[7];
+      setupStandardFixture(pq, handles);
+      // exercise
+      int value = pq.pop_value();
+      // verify
+      assertUnit(value == 10);
+      assertUnit(!pq.contains(handles[0]));
+      assertUnit(pq.size() == 6);
+      assertUnit(popAll(pq) == std::string("9 8 7 5 4 3 "));
+   }  // teardown
+
+   /***************************************
+    * CANCEL
+    ***************************************/
+
+   // cancel the top: it leaves the heap at once
+   void test_cancel_top()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::lazy_priority_queue <int> pq;
+      uint64_t handles[7];
+      setupStandardFixture(pq, handles);
+      // exercise
+      bool isCancelled = pq.cancel(handles[0]);
+      // verify
+      assertUnit(isCancelled);
+      assertUnit(pq.size() == 6);
+      assertUnit(pq.heap.size() == 6);
+      assertUnit(pq.numDead == 0);
+      assertUnit(pq.top() == 9);
+   }  // teardown
+
+   // cancel an item deep in the heap: it stays as a tombstone
+   void test_cancel_buried()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::lazy_priority_queue <int> pq;
+      uint64_t handles[7];
+      setupStandardFixture(pq, handles);
+      // exercise
+      pq.cancel(handles[3]);
+      // verify
+      assertUnit(!pq.contains(handles[3]));
+      assertUnit(pq.size() == 6);
+      assertUnit(pq.heap.size() == 7);
+      assertUnit(pq.numDead == 1);
+      assertUnit(popAll(pq) == std::string("10 9 8 7 5 3 "));
+      assertUnit(pq.heap.empty());
+   }  // teardown
+
+   // a tombstone under the top is dropped as soon as it surfaces
+   void test_cancel_thenPop()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::lazy_priority_queue <int> pq;
+      uint64_t handles[7];
+      setupStandardFixture(pq, handles);
+      pq.cancel(handles[2]);
+      // exercise
+      pq.pop();
+      // verify
+      assertUnit(pq.top() == 8);
+      assertUnit(pq.size() == 5);
+      assertUnit(pq.heap.size() == 5);
+      assertUnit(pq.numDead == 0);
+   }  // teardown
+
+   // cancel an item that was already popped does nothing
+   void test_cancel_popped()
+   {  // setup
+      custom::lazy_priority_queue <int> pq;
+      uint64_t h = pq.push(5);
+      pq.push(3);
+      pq.pop();
+      // exercise
+      bool isCancelled = pq.cancel(h);
+      // verify
+      assertUnit(!isCancelled);
+      assertUnit(pq.size() == 1);
+      assertUnit(pq.top() == 3);
+   }  // teardown
+
+   // cancel the same item twice counts it once
+   void test_cancel_twice()
+   {  // setup
+      custom::lazy_priority_queue <int> pq;
+      pq.max_dead_ratio(1.0);
+      pq.push(9);
+      uint64_t h = pq.push(5);
+      pq.push(3);
+      pq.cancel(h);
+      // exercise
+      bool isCancelled = pq.cancel(h);
+      // verify
+      assertUnit(!isCancelled);
+      assertUnit(pq.numDead == 1);
+      assertUnit(pq.size() == 2);
+   }  // teardown
+
+   // a stale handle does not cancel the item that reused its slot
+   void test_cancel_recycled()
+   {  // setup
+      custom::lazy_priority_queue <int> pq;
+      uint64_t hOld = pq.push(5);
+      pq.pop();
+      uint64_t hNew = pq.push(7);
+      // exercise
+      bool isCancelled = pq.cancel(hOld);
+      // verify
+      assertUnit(uint32_t(hOld) == uint32_t(hNew));
+      assertUnit(hOld != hNew);
+      assertUnit(!isCancelled);
+      assertUnit(pq.contains(hNew));
+      assertUnit(pq.top() == 7);
+   }  // teardown
+
+   // cancel everything: the queue is empty
+   void test_cancel_all()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::lazy_priority_queue <int> pq;
+      uint64_t handles[7];
+      setupStandardFixture(pq, handles);
+      pq.max_dead_ratio(1.0);
+      // exercise
+      for (int i = 6; i >= 0; i--)
+         pq.cancel(handles[i]);
+      // verify
+      assertUnit(pq.empty());
+      assertUnit(pq.heap.empty());
+      assertUnit(pq.numDead == 0);
+   }  // teardown
+
+   // passing the dead ratio drops every tombstone
+   void test_cancel_compact()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::lazy_priority_queue <int> pq;
+      uint64_t handles[7];
+      setupStandardFixture(pq, handles);
+      pq.cancel(handles[1]);  // 8
+      pq.cancel(handles[3]);  // 4
+      pq.cancel(handles[5]);  // 7
+      assertUnit(pq.heap.size() == 7);
+      // exercise
+      pq.cancel(handles[6]);  // 5
+      // verify
+      assertUnit(pq.heap.size() == 3);
+      assertUnit(pq.numDead == 0);
+      assertUnit(pq.freeSlots.size() == 4);
+      assertUnit(popAll(pq) == std::string("10 9 3 "));
+   }  // teardown
+
+   // lowering the dead ratio compacts right away
+   void test_maxDeadRatio_compact()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::lazy_priority_queue <int> pq;
+      uint64_t handles[7];
+      setupStandardFixture(pq, handles);
+      pq.cancel(handles[4]);  // 3
+      assertUnit(pq.numDead == 1);
+      // exercise
+      pq.max_dead_ratio(0.1);
+      // verify
+      assertUnit(pq.max_dead_ratio() == 0.1);
+      assertUnit(pq.heap.size() == 6);
+      assertUnit(pq.numDead == 0);
+      assertUnit(popAll(pq) == std::string("10 9 8 7 5 4 "));
+   }  // teardown
+
+   /***************************************************
+    * SETUP STANDARD FIXTURE
+    *               10
+    *         8            9
+    *      4     3      7     5
+    * and the handles in the same order
+    ***************************************************/
+   void setupStandardFixture(custom::lazy_priority_queue <int> & pq, uint64_t handles[7])
+   {
+      int values[] = { 10, 8, 9, 4, 3, 7, 5 };
+      for (int i = 0; i < 7; i++)
+         handles[i] = pq.push(values[i]);
+   }
+
+   /***************************************************
+    * POP ALL
+    * Empty the queue, spelling out the items in order
+    ***************************************************/
+   std::string popAll(custom::lazy_priority_queue <int> & pq)
+   {
+      std::string values;
+      while (!pq.empty())
+      {
+         values += std::to_string(pq.top()) + " ";
+         pq.pop();
+      }
+      return values;
+   }
+};
+
+#endif // DEBUG
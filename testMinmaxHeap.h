@@ -0,0 +1,271 @@
+/***********************************************************************
+ * Header:
+ *    TEST MINMAX HEAP
+ * Summary:
+ *    Unit tests for the min-max heap
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "minmax_heap.h"   // class under test
+#include "unitTest.h"      // unit test baseclass
+#include "spy.h"
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+class TestMinmaxHeap : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Access
+      test_top_empty();
+      test_top_one();
+
+      // Insert
+      test_push_standard();
+      test_push_spy();
+
+      // Remove
+      test_popMin_standard();
+      test_popMax_standard();
+      test_popMax_greater();
+      test_pop_mixed();
+      test_pop_spy();
+
+      report("MinmaxHeap");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::minmax_heap <int> heap;
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.size() == 0);
+      assertUnit(heap.container.size() == 0);
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // both tops throw when there is nothing
+   void test_top_empty()
+   {  // setup
+      custom::minmax_heap <int> heap;
+      bool isMinThrown = false;
+      bool isMaxThrown = false;
+      // exercise
+      try { heap.top_min(); } catch (const char *) { isMinThrown = true; }
+      try { heap.top_max(); } catch (const char *) { isMaxThrown = true; }
+      // verify
+      assertUnit(isMinThrown);
+      assertUnit(isMaxThrown);
+   }  // teardown
+
+   // a single item is both the smallest and the largest
+   void test_top_one()
+   {  // setup
+      custom::minmax_heap <int> heap;
+      // exercise
+      heap.push(7);
+      // verify
+      assertUnit(heap.top_min() == 7);
+      assertUnit(heap.top_max() == 7);
+      heap.pop_max();
+      assertUnit(heap.empty());
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push the standard fixture, a min level then a max level
+   //                3
+   //          10          9
+   //       4     8      7     5
+   void test_push_standard()
+   {  // setup
+      custom::minmax_heap <int> heap;
+      // exercise
+      setupStandardFixture(heap);
+      // verify
+      assertUnit(heap.size() == 7);
+      assertUnit(isMinmaxHeap(heap));
+      assertUnit(heap.top_min() == 3);
+      assertUnit(heap.top_max() == 10);
+      assertUnit(heap.container[0] == 3);
+   }  // teardown
+
+   // push moves an rvalue in, and makes no copies climbing up
+   void test_push_spy()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      for (int i = 0; i < 15; i++)
+         heap.push(Spy((i * 7) % 15));
+      Spy::reset();
+      // exercise
+      heap.push(Spy(100));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(heap.top_max().get() == 100);
+      assertUnit(heap.top_min().get() == 0);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop_min hands out the items smallest first
+   void test_popMin_standard()
+   {  // setup
+      custom::minmax_heap <int> heap;
+      setupStandardFixture(heap);
+      std::vector <int> values;
+      // exercise
+      while (!heap.empty())
+      {
+         values.push_back(heap.top_min());
+         heap.pop_min();
+         assertUnit(isMinmaxHeap(heap));
+      }
+      // verify
+      assertUnit(values == std::vector<int>({ 3, 4, 5, 7, 8, 9, 10 }));
+   }  // teardown
+
+   // pop_max hands out the items largest first
+   void test_popMax_standard()
+   {  // setup
+      custom::minmax_heap <int> heap;
+      setupStandardFixture(heap);
+      std::vector <int> values;
+      // exercise
+      while (!heap.empty())
+      {
+         values.push_back(heap.top_max());
+         heap.pop_max();
+         assertUnit(isMinmaxHeap(heap));
+      }
+      // verify
+      assertUnit(values == std::vector<int>({ 10, 9, 8, 7, 5, 4, 3 }));
+   }  // teardown
+
+   // std::greater turns the two ends around
+   void test_popMax_greater()
+   {  // setup
+      custom::minmax_heap <std::string, std::greater<std::string> > heap;
+      for (const char * word : { "cab", "a", "dog", "zz", "bee", "ox" })
+         heap.push(std::string(word));
+      // exercise
+      std::string first = heap.top_max();
+      heap.pop_max();
+      // verify
+      assertUnit(first == std::string("a"));
+      assertUnit(heap.top_max() == std::string("bee"));
+      assertUnit(heap.top_min() == std::string("zz"));
+   }  // teardown
+
+   // pops from both ends, mixed with pushes, agree with a sorted list
+   void test_pop_mixed()
+   {  // setup
+      custom::minmax_heap <int> heap;
+      std::vector <int> sorted;
+      bool isSame = true;
+      // exercise
+      for (int i = 0; i < 2000; i++)
+      {
+         int value = (i * 7919) % 1009;
+         heap.push(value);
+         sorted.insert(std::upper_bound(sorted.begin(), sorted.end(), value), value);
+         if (i % 3 == 1)
+         {
+            isSame = isSame && heap.top_max() == sorted.back();
+            heap.pop_max();
+            sorted.pop_back();
+         }
+         if (i % 5 == 2)
+         {
+            isSame = isSame && heap.top_min() == sorted.front();
+            heap.pop_min();
+            sorted.erase(sorted.begin());
+         }
+      }
+      // verify
+      assertUnit(isSame);
+      assertUnit(heap.size() == sorted.size());
+      assertUnit(isMinmaxHeap(heap));
+   }  // teardown
+
+   // pops move items around rather than copying them
+   void test_pop_spy()
+   {  // setup
+      custom::minmax_heap <Spy> heap;
+      for (int i = 0; i < 100; i++)
+         heap.push(Spy((i * 37) % 100));
+      Spy::reset();
+      // exercise
+      heap.pop_max();
+      heap.pop_min();
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(heap.top_max().get() == 98);
+      assertUnit(heap.top_min().get() == 1);
+   }  // teardown
+
+   /***************************************************
+    * IS MINMAX HEAP
+    * Every item is no bigger than its descendants on
+    * a min level, and no smaller on a max level
+    ***************************************************/
+   template <class T, class Compare>
+   bool isMinmaxHeap(custom::minmax_heap <T, Compare> & heap)
+   {
+      Compare compare;
+      for (size_t indexHeap = 2; indexHeap <= heap.size(); indexHeap++)
+         for (size_t indexAbove = indexHeap / 2; indexAbove >= 1; indexAbove /= 2)
+         {
+            bool isMax = custom::minmax_heap <T, Compare>::isMaxLevel(indexAbove);
+            const T & above = heap.containerAt(indexAbove);
+            const T & below = heap.containerAt(indexHeap);
+            if (isMax ? compare(above, below) : compare(below, above))
+               return false;
+         }
+      return true;
+   }
+
+   /***************************************************
+    * SETUP STANDARD FIXTURE
+    *                3
+    *          10          9
+    *       4     8      7     5
+    ***************************************************/
+   void setupStandardFixture(custom::minmax_heap <int> & heap)
+   {
+      for (int value : { 10, 8, 9, 4, 3, 7, 5 })
+         heap.push(value);
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,447 @@
+/***********************************************************************
+ * Header:
+ *    TEST PAIRING HEAP
+ * Summary:
+ *    Unit tests for the pairing heap and its node pool
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "pairing_heap.h"   // class under test
+#include "unitTest.h"       // unit test baseclass
+#include "spy.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+
+class TestPairingHeap : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+      test_construct_move();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_standard();
+      test_push_spy();
+
+      // Meld
+      test_meld_standard();
+      test_meld_empty();
+      test_meld_handles();
+
+      // Change
+      test_decreaseKey_root();
+      test_decreaseKey_deep();
+      test_decreaseKey_invalid();
+
+      // Remove
+      test_pop_standard();
+      test_pop_mixed();
+      test_clear_spy();
+
+      // Pool
+      test_pool_recycle();
+      test_pool_splice();
+
+      report("PairingHeap");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::pairing_heap <int> heap;
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.size() == 0);
+      assertUnit(heap.pRoot == nullptr);
+      assertUnit(heap.pool.blockFirst == nullptr);
+   }  // teardown
+
+   // move constructor takes the nodes and the pool
+   void test_construct_move()
+   {  // setup
+      custom::pairing_heap <int> heapSrc;
+      setupStandardFixture(heapSrc);
+      // exercise
+      custom::pairing_heap <int> heapDest(std::move(heapSrc));
+      // verify
+      assertUnit(heapSrc.empty());
+      assertUnit(heapSrc.pool.blockFirst == nullptr);
+      assertUnit(heapDest.size() == 7);
+      assertUnit(popAll(heapDest) == std::string("9 8 7 5 4 3 1 "));
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // top of an empty heap throws
+   void test_top_empty()
+   {  // setup
+      custom::pairing_heap <int> heap;
+      // exercise
+      try
+      {
+         heap.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push links each node under the root or over it
+   void test_push_standard()
+   {  // setup
+      custom::pairing_heap <int> heap;
+      // exercise
+      setupStandardFixture(heap);
+      // verify
+      assertUnit(heap.size() == 7);
+      assertUnit(heap.top() == 9);
+      assertUnit(heap.top_handle() == heap.pRoot);
+      assertUnit(heap.pRoot->pPrev == nullptr);
+      assertUnit(heap.pRoot->pSibling == nullptr);
+      assertUnit(isPairingHeap(heap));
+   }  // teardown
+
+   // an rvalue is moved into its node, and nothing moves after that
+   void test_push_spy()
+   {  // setup
+      custom::pairing_heap <Spy> heap;
+      for (int i = 0; i < 20; i++)
+         heap.push(Spy((i * 7) % 20));
+      Spy::reset();
+      // exercise
+      heap.push(Spy(100));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 1);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(heap.top().get() == 100);
+   }  // teardown
+
+   /***************************************
+    * MELD
+    ***************************************/
+
+   // meld two heaps: the items and the pool of the rhs come over
+   void test_meld_standard()
+   {  // setup
+      custom::pairing_heap <int> heapLHS;
+      custom::pairing_heap <int> heapRHS;
+      setupStandardFixture(heapLHS);
+      for (int value : { 6, 10, 2 })
+         heapRHS.push(value);
+      // exercise
+      heapLHS.meld(std::move(heapRHS));
+      // verify
+      assertUnit(heapRHS.empty());
+      assertUnit(heapRHS.pRoot == nullptr);
+      assertUnit(heapRHS.pool.blockFirst == nullptr);
+      assertUnit(heapLHS.size() == 10);
+      assertUnit(heapLHS.top() == 10);
+      assertUnit(isPairingHeap(heapLHS));
+      assertUnit(popAll(heapLHS) == std::string("10 9 8 7 6 5 4 3 2 1 "));
+   }  // teardown
+
+   // meld into an empty heap, and meld an empty heap in
+   void test_meld_empty()
+   {  // setup
+      custom::pairing_heap <int> heapEmpty;
+      custom::pairing_heap <int> heapFull;
+      custom::pairing_heap <int> heapNone;
+      setupStandardFixture(heapFull);
+      // exercise
+      heapEmpty.meld(std::move(heapFull));
+      heapEmpty.meld(std::move(heapNone));
+      heapEmpty.meld(std::move(heapEmpty));
+      // verify
+      assertUnit(heapFull.empty());
+      assertUnit(heapNone.empty());
+      assertUnit(heapEmpty.size() == 7);
+      assertUnit(popAll(heapEmpty) == std::string("9 8 7 5 4 3 1 "));
+   }  // teardown
+
+   // handles of the rhs still name their items after a meld
+   void test_meld_handles()
+   {  // setup
+      custom::pairing_heap <int> heapLHS;
+      custom::pairing_heap <int> heapRHS;
+      setupStandardFixture(heapLHS);
+      heapRHS.push(6);
+      custom::pairing_heap <int>::handle h = heapRHS.push(2);
+      // exercise
+      heapLHS.meld(std::move(heapRHS));
+      heapLHS.decrease_key(h, 11);
+      // verify
+      assertUnit(heapLHS.get(h) == 11);
+      assertUnit(heapLHS.top_handle() == h);
+      assertUnit(popAll(heapLHS) == std::string("11 9 8 7 6 5 4 3 1 "));
+   }  // teardown
+
+   /***************************************
+    * DECREASE KEY
+    ***************************************/
+
+   // raising the root leaves it where it is
+   void test_decreaseKey_root()
+   {  // setup
+      custom::pairing_heap <int> heap;
+      setupStandardFixture(heap);
+      custom::pairing_heap <int>::handle h = heap.top_handle();
+      // exercise
+      heap.decrease_key(h, 20);
+      // verify
+      assertUnit(heap.top_handle() == h);
+      assertUnit(heap.top() == 20);
+      assertUnit(isPairingHeap(heap));
+   }  // teardown
+
+   // a node deep in the tree is cut loose with its subtree
+   void test_decreaseKey_deep()
+   {  // setup
+      custom::pairing_heap <int, std::greater<int> > heap;
+      std::vector<custom::pairing_heap <int, std::greater<int> >::handle> handles;
+      for (int i = 0; i < 100; i++)
+         handles.push_back(heap.push(1000 + (i * 37) % 100));
+      heap.pop();
+      heap.pop();
+      // exercise
+      for (int i = 10; i < 100; i += 10)
+         heap.decrease_key(handles[i], heap.get(handles[i]) - 1000);
+      // verify
+      assertUnit(heap.size() == 98);
+      assertUnit(isPairingHeap(heap));
+      std::vector<int> values;
+      while (!heap.empty())
+         values.push_back(heap.pop_value());
+      bool isSorted = true;
+      for (size_t i = 1; i < values.size(); i++)
+         isSorted = isSorted && values[i - 1] <= values[i];
+      assertUnit(isSorted);
+      assertUnit(values.size() == 98);
+      assertUnit(values.front() < 100);
+   }  // teardown
+
+   // a new value that belongs lower throws and changes nothing
+   void test_decreaseKey_invalid()
+   {  // setup
+      custom::pairing_heap <int> heap;
+      setupStandardFixture(heap);
+      custom::pairing_heap <int>::handle h = heap.top_handle();
+      // exercise
+      try
+      {
+         heap.decrease_key(h, 2);
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("std:invalid_argument"));
+      }
+      assertUnit(heap.top() == 9);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop hands the items out biggest first
+   void test_pop_standard()
+   {  // setup
+      custom::pairing_heap <int> heap;
+      setupStandardFixture(heap);
+      // exercise
+      heap.pop();
+      // verify
+      assertUnit(heap.size() == 6);
+      assertUnit(heap.top() == 8);
+      assertUnit(isPairingHeap(heap));
+      assertUnit(popAll(heap) == std::string("8 7 5 4 3 1 "));
+      heap.pop();
+      assertUnit(heap.empty());
+   }  // teardown
+
+   // pushes and pops mixed, against a plain priority_queue
+   void test_pop_mixed()
+   {  // setup
+      custom::pairing_heap <int> heap;
+      custom::priority_queue <int> pq;
+      bool isSame = true;
+      // exercise
+      for (int i = 0; i < 3000; i++)
+      {
+         int value = (i * 7919) % 1009;
+         heap.push(value);
+         pq.push(value);
+         if (i % 3 == 2)
+         {
+            isSame = isSame && heap.pop_value() == pq.pop_value();
+         }
+      }
+      // verify
+      assertUnit(isSame);
+      assertUnit(heap.size() == pq.size());
+      assertUnit(isPairingHeap(heap));
+      while (!heap.empty())
+         isSame = isSame && heap.pop_value() == pq.pop_value();
+      assertUnit(isSame);
+   }  // teardown
+
+   // clear destroys every item once, and keeps the blocks
+   void test_clear_spy()
+   {  // setup
+      custom::pairing_heap <Spy> heap;
+      for (int i = 0; i < 300; i++)
+         heap.push(Spy(i));
+      heap.pop();
+      Spy::reset();
+      // exercise
+      heap.clear();
+      // verify
+      assertUnit(Spy::numDestructor() == 299);
+      assertUnit(heap.empty());
+      assertUnit(heap.pRoot == nullptr);
+      assertUnit(heap.pool.blockFirst != nullptr);
+   }  // teardown
+
+   /***************************************
+    * NODE POOL
+    ***************************************/
+
+   // a popped node is the next one a push gets
+   void test_pool_recycle()
+   {  // setup
+      custom::pairing_heap <int> heap;
+      setupStandardFixture(heap);
+      custom::pairing_heap <int>::handle hOld = heap.top_handle();
+      heap.pop();
+      // exercise
+      custom::pairing_heap <int>::handle hNew = heap.push(6);
+      // verify
+      assertUnit(hNew == hOld);
+      assertUnit(heap.pool.blockFirst == heap.pool.blockLast);
+   }  // teardown
+
+   // splice chains the blocks and the free lists of both pools
+   void test_pool_splice()
+   {  // setup
+      custom::node_pool <int, 4> poolLHS;
+      custom::node_pool <int, 4> poolRHS;
+      int * pLHS = poolLHS.create(1);
+      int * pRHS = poolRHS.create(2);
+      // exercise
+      poolLHS.splice(poolRHS);
+      // verify
+      assertUnit(poolRHS.blockFirst == nullptr);
+      assertUnit(poolRHS.freeFirst == nullptr);
+      assertUnit(poolLHS.blockFirst != poolLHS.blockLast);
+      assertUnit(numFree(poolLHS) == 6);
+      poolLHS.destroy(pLHS);
+      poolLHS.destroy(pRHS);
+      assertUnit(numFree(poolLHS) == 8);
+   }  // teardown
+
+   /***************************************************
+    * IS PAIRING HEAP
+    * No child beats its parent, every pPrev points back
+    * to the node that points at it, and the nodes are
+    * all counted
+    ***************************************************/
+   template <class T, class Compare>
+   bool isPairingHeap(const custom::pairing_heap <T, Compare> & heap)
+   {
+      typedef typename custom::pairing_heap <T, Compare>::node node;
+      Compare compare;
+      if (!heap.pRoot)
+         return heap.size() == 0;
+      if (heap.pRoot->pPrev || heap.pRoot->pSibling)
+         return false;
+
+      size_t num = 0;
+      std::vector<const node *> stack(1, heap.pRoot);
+      while (!stack.empty())
+      {
+         const node * pNode = stack.back();
+         stack.pop_back();
+         num++;
+         for (const node * pChild = pNode->pChild; pChild; pChild = pChild->pSibling)
+         {
+            const node * pLeft = pChild == pNode->pChild ? pNode : pChild->pPrev;
+            if (pChild->pPrev != pLeft || compare(pNode->value, pChild->value))
+               return false;
+            if (pLeft != pNode && pLeft->pSibling != pChild)
+               return false;
+            stack.push_back(pChild);
+         }
+      }
+      return num == heap.size();
+   }
+
+   /***************************************************
+    * NUM FREE
+    * How many slots are on the free list of a pool
+    ***************************************************/
+   template <class Node, size_t BlockNodes>
+   size_t numFree(const custom::node_pool <Node, BlockNodes> & pool)
+   {
+      size_t num = 0;
+      for (auto pSlot = pool.freeFirst; pSlot; pSlot = pSlot->pNext)
+         num++;
+      return num;
+   }
+
+   /***************************************************
+    * POP ALL
+    * Drain the heap into a string, top first
+    ***************************************************/
+   template <class Compare>
+   std::string popAll(custom::pairing_heap <int, Compare> & heap)
+   {
+      std::string s;
+      while (!heap.empty())
+         s += std::to_string(heap.pop_value()) + " ";
+      return s;
+   }
+
+   /***************************************************
+    * SETUP STANDARD FIXTURE
+    * Push 7 5 9 1 3 4 8, so nodes end up at every depth
+    ***************************************************/
+   void setupStandardFixture(custom::pairing_heap <int> & heap)
+   {
+      for (int value : { 7, 5, 9, 1, 3, 4, 8 })
+         heap.push(value);
+   }
+};
+
+#endif // DEBUG
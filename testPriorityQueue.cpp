@@ -16,8 +16,18 @@
  //#undef DEBUG  // Remove this comment to disable unit tests
 
 #include "testPriorityQueue.h"  // for the priority queue unit tests
+#include "testStablePriorityQueue.h" // for the stable priority queue unit tests
+#include "testIndexedPriorityQueue.h" // for the indexed priority queue unit tests
+#include "testLazyPriorityQueue.h" // for the lazy priority queue unit tests
+#include "testKeyedPriorityQueue.h" // for the keyed priority queue unit tests
+#include "testSplitPriorityQueue.h" // for the split priority queue unit tests
+#include "testSimdChild.h"      // for the vector child search unit tests
+#include "testMinmaxHeap.h"     // for the min-max heap unit tests
+#include "testPairingHeap.h"    // for the pairing heap unit tests
+#include "testRadixHeap.h"      // for the radix heap unit tests
 #include "testSpy.h"            // for the spy unit tests
 #include "testVector.h"         // for the vector unit tests
+#include "benchPriorityQueue.h" // for the priority queue benchmarks
 int Spy::counters[] = {};
 
 /**********************************************************************
@@ -31,7 +41,21 @@ int main()
    TestSpy().run();
    TestVector().run();
    TestPQueue().run();
+   TestStablePQueue().run();
+   TestIPQueue().run();
+   TestLazyPQueue().run();
+   TestKeyedPQueue().run();
+   TestSplitPQueue().run();
+   TestSimdChild().run();
+   TestMinmaxHeap().run();
+   TestPairingHeap().run();
+   TestRadixHeap().run();
 #endif // DEBUG
+
+#ifdef BENCHMARK
+   // timings
+   BenchPQueue().run();
+#endif // BENCHMARK
    
    return 0;
 }
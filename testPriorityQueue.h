@@ -17,6 +17,8 @@
 
 #include <cassert>
 #include <memory>
+#include <vector>
+#include <iterator>
 
 
 class TestPQueue : public UnitTest
@@ -36,9 +38,14 @@ public:
       test_constructRange_empty();
       test_constructRange_one();
       test_constructRange_staandard();
+      test_constructRange_unordered();
       test_constructMoveInit_empty();
       test_constructMoveInit_one();
       test_constructMoveInit_standard();
+      test_constructMoveInit_unordered();
+      test_constructMoveInit_steal();
+      test_constructCompare_stateless();
+      test_constructCompare_stateful();
       
       // Assign
       test_swap_emptyEmpty();
@@ -61,12 +68,62 @@ public:
       test_pushMove_levelOne();
       test_pushMove_levelTwo();
       test_pushMove_levelThree();
+      test_push_greater();
+      test_push_spyLevelZero();
+      test_push_spyLevelTwo();
+      test_push_quaternary();
+      test_emplace_levelZero();
+      test_emplace_levelTwo();
+      test_pushRange_empty();
+      test_pushRange_small();
+      test_pushRange_large();
+      test_pushRange_move();
+      test_merge_empty();
+      test_merge_steal();
+      test_merge_standard();
+      test_merge_spy();
 
       // Remove
       test_pop_empty();
       test_pop_one();
       test_pop_two();
       test_pop_standard();
+      test_pop_greater();
+      test_pop_spy();
+      test_pop_quaternary();
+      test_pop_octonary();
+      test_pop_bottomUpStandard();
+      test_pop_bottomUpDeep();
+      test_popValue_empty();
+      test_popValue_standard();
+      test_popValue_spy();
+      test_tryPop_empty();
+      test_tryPop_standard();
+      test_tryPop_spy();
+      test_replaceTop_empty();
+      test_replaceTop_standard();
+      test_replaceTop_spy();
+      test_pushPop_empty();
+      test_pushPop_newTop();
+      test_pushPop_standard();
+      test_popN_empty();
+      test_popN_standard();
+      test_popN_few();
+      test_popN_select();
+      test_popN_spy();
+      test_eraseIf_empty();
+      test_eraseIf_none();
+      test_eraseIf_standard();
+      test_eraseIf_all();
+      test_eraseIf_spy();
+      test_retainIf_standard();
+
+      // Layout
+      test_layoutBlocked_navigate();
+      test_layoutBlocked_heapify();
+      test_layoutBlocked_pushPop();
+      test_layoutBlocked_bulk();
+      test_layoutBlocked_aligned();
        
       // Status
       test_size_empty();
@@ -79,6 +136,9 @@ public:
       test_percolateDown_nothing();
       test_percolateDown_oneLevel();
       test_percolateDown_twoLevels();
+      test_percolateDown_spyTwoLevels();
+      test_percolateUp_nothing();
+      test_percolateUp_twoLevels();
 
       report("PQueue");
    }
@@ -245,6 +305,36 @@ public:
       teardownStandardFixture(pq);
    }
    
+   // priority_queue({3, 4, 5, 7, 8, 9, 10})
+   void test_constructRange_unordered()
+   {  // setup
+      //  il = {3, 4, 5, 7, 8, 9, 10}
+      std::initializer_list<int> il{int(3), int(4), int(5), int(7), int(8), int(9), int(10)};
+      // exercise
+      custom::priority_queue<int> pq(il.begin(), il.end());
+      // verify
+      //    1   2   3   4   5   6   7
+      //  +---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 7 | 4 | 3 | 5 |
+      //  +---+---+---+---+---+---+---+
+      //                10
+      //          8            9
+      //       7     4      3     5
+      assertUnit(pq.container.size() == 7);
+      if (pq.container.size() == 7)
+      {
+         assertUnit(pq.container[0] == int(10));
+         assertUnit(pq.container[1] == int(8));
+         assertUnit(pq.container[2] == int(9));
+         assertUnit(pq.container[3] == int(7));
+         assertUnit(pq.container[4] == int(4));
+         assertUnit(pq.container[5] == int(3));
+         assertUnit(pq.container[6] == int(5));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
    /***************************************
     * MOVE CONTAINER INITIALIZE CONSTRUCTOR
     ***************************************/
@@ -315,6 +405,87 @@ public:
       teardownStandardFixture(pq);
    }
    
+   // priority_queue(move([4, 3, 10, 8, 5, 7, 9]))
+   void test_constructMoveInit_unordered()
+   {  // setup
+      //   v = [4, 3, 10, 8, 5, 7, 9]
+      custom::vector <int> v{int(4), int(3), int(10), int(8), int(5), int(7), int(9)};
+      // exercise
+      custom::priority_queue <int> pq(std::move(v));
+      // verify
+      //    1   2   3   4   5   6   7
+      //  +---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 3 | 5 | 7 | 4 |
+      //  +---+---+---+---+---+---+---+
+      //                10
+      //          8            9
+      //       3     5      7     4
+      assertUnit(pq.container.size() == 7);
+      if (pq.container.size() == 7)
+      {
+         assertUnit(pq.container[0] == int(10));
+         assertUnit(pq.container[1] == int(8));
+         assertUnit(pq.container[2] == int(9));
+         assertUnit(pq.container[3] == int(3));
+         assertUnit(pq.container[4] == int(5));
+         assertUnit(pq.container[5] == int(7));
+         assertUnit(pq.container[6] == int(4));
+      }
+      assertUnit(v.size() == 0);
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // priority_queue(move(v)) takes the buffer without copying an item
+   void test_constructMoveInit_steal()
+   {  // setup
+      //   v = [10, 8, 9]
+      custom::vector <Spy> v{Spy(10), Spy(8), Spy(9)};
+      Spy * pData = v.data;
+      Spy::reset();
+      // exercise
+      custom::priority_queue <Spy> pq(std::move(v));
+      // verify
+      assertUnit(pq.container.data == pData);
+      assertUnit(pq.container.size() == 3);
+      assertUnit(v.data == nullptr);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+   }  // teardown
+
+   /***************************************
+    * COMPARE CONSTRUCTOR
+    ***************************************/
+
+   // a stateless comparator takes no space
+   void test_constructCompare_stateless()
+   {  // setup
+      // exercise
+      custom::priority_queue <int, std::greater<int>> pq;
+      // verify
+      assertUnit(sizeof(pq) == sizeof(custom::vector <int>));
+      assertUnit(sizeof(custom::priority_queue <int>) == sizeof(custom::vector <int>));
+      assertEmptyFixture(pq);
+   }  // teardown
+
+   // a comparator with state is copied into the priority queue
+   void test_constructCompare_stateful()
+   {  // setup
+      //  il = {4, 9, 7}
+      std::initializer_list<int> il{int(4), int(9), int(7)};
+      // exercise
+      custom::priority_queue <int, CompareDirection> pq(il.begin(), il.end(),
+                                                        CompareDirection(true /*isMin*/));
+      // verify
+      assertUnit(pq.value_comp().isMin == true);
+      assertUnit(pq.container.size() == 3);
+      pq.push(int(1));
+      assertUnit(pq.top() == int(1));
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
    /***************************************
     * SIZE EMPTY
     ***************************************/
@@ -594,6 +765,91 @@ public:
 
 
 
+   // percolate down two levels moves each item once: no swaps
+   void test_percolateDown_spyTwoLevels()
+   {  // setup
+      //    1   2   3   4   5   6   7
+      //  +---+---+---+---+---+---+---+
+      //  | 5 | 8 | 10| 4 | 3 | 7 | 9 |
+      //  +---+---+---+---+---+---+---+
+      //               5
+      //         8            10
+      //      4     3      7     9
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(5), Spy(8), Spy(10), Spy(4), Spy(3), Spy(7), Spy(9)};
+      Spy::reset();
+      // Exercise
+      bool changed = pq.percolateDown(1 /*indexHeap*/);
+      // Verify
+      //    1   2   3   4   5   6   7
+      //  +---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |
+      //  +---+---+---+---+---+---+---+
+      //               10
+      //         8            9
+      //      4     3      7     5
+      assertUnit(changed == true);
+      assertUnit(Spy::numCopyMove() == 1);   // lift the 5 out
+      assertUnit(Spy::numAssignMove() == 3); // 10 up, 9 up, 5 back in
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numLessthan() == 4);
+      assertUnit(pq.container.size() == 7);
+      if (pq.container.size() == 7)
+      {
+         assertUnit(pq.container[0] == Spy(10));
+         assertUnit(pq.container[1] == Spy(8));
+         assertUnit(pq.container[2] == Spy(9));
+         assertUnit(pq.container[6] == Spy(5));
+      }
+   }  // Teardown
+
+   // test percolate up with no change
+   void test_percolateUp_nothing()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // Exercise
+      bool changed = pq.percolateUp(7 /*indexHeap*/);
+      // Verify
+      assertUnit(changed == false);
+      assertStandardFixture(pq);
+      // Teardown
+      teardownStandardFixture(pq);
+   }
+
+   // test percolate up from a leaf to the root
+   void test_percolateUp_twoLevels()
+   {  // setup
+      //    1   2   3   4   5   6   7
+      //  +---+---+---+---+---+---+---+
+      //  | 9 | 8 | 5 | 4 | 3 | 7 | 10|
+      //  +---+---+---+---+---+---+---+
+      //               9
+      //         8            5
+      //      4     3      7     10
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      pq.container[1-1] = int(9);
+      pq.container[3-1] = int(5);
+      pq.container[7-1] = int(10);
+      // Exercise
+      bool changed = pq.percolateUp(7 /*indexHeap*/);
+      // Verify
+      //    1   2   3   4   5   6   7
+      //  +---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |
+      //  +---+---+---+---+---+---+---+
+      assertUnit(changed == true);
+      assertStandardFixture(pq);
+      // Teardown
+      teardownStandardFixture(pq);
+   }
+
    /***************************************
     * TOP
     ***************************************/
@@ -759,170 +1015,981 @@ public:
 
    
 
-   /***************************************
-    * PUSH
-    ***************************************/
-
-   void test_push_empty()
+   // pop a min heap until it is empty
+   void test_pop_greater()
    {  // setup
-      custom::priority_queue <int> pq;
-      int s(10);
+      //                3
+      //          4            5
+      //       10    8      9     7
+      //  +---+---+---+---+---+---+---+
+      //  | 3 | 4 | 5 | 10| 8 | 9 | 7 |
+      //  +---+---+---+---+---+---+---+
+      custom::priority_queue <int, std::greater<int>> pq;
+      pq.container = {int(3), int(4), int(5), int(10), int(8), int(9), int(7)};
+      int values[7];
       // exercise
-      pq.push(s);
+      for (int i = 0; i < 7; i++)
+      {
+         values[i] = pq.top();
+         pq.pop();
+      }
       // verify
-      //  +----+
-      //  | 10 |
-      //  +----+
-      assertUnit(pq.container.size() == 1);
-      if (pq.container.size() == 1)
-         assertUnit(pq.container[0] == int(10));
-      // teardown
-      teardownStandardFixture(pq);
-   }
+      assertUnit(values[0] == int(3));
+      assertUnit(values[1] == int(4));
+      assertUnit(values[2] == int(5));
+      assertUnit(values[3] == int(7));
+      assertUnit(values[4] == int(8));
+      assertUnit(values[5] == int(9));
+      assertUnit(values[6] == int(10));
+      assertEmptyFixture(pq);
+   }  // teardown
 
-   // push an element to the bottom of a priority queue - level zero
-   void test_push_levelZero()
+   // pop the standard fixture moves rather than swaps
+   void test_pop_spy()
    {  // setup
-      //  +---+---+---+---+---+---+---+---+---+
-      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |   |   |
-      //  +---+---+---+---+---+---+---+---+---+
-      //                10
-      //          8            9
-      //       4     3      7     5
-      custom::priority_queue <int> pq;
-      setupStandardFixture(pq);
-      int s(1);
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9), Spy(4), Spy(3), Spy(7), Spy(5)};
+      Spy::reset();
       // exercise
-      pq.push(s);
+      pq.pop();
       // verify
-      //    1   2   3   4   5   6   7   8
-      //  +---+---+---+---+---+---+---+---+---+
-      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 | 1 |   |
-      //  +---+---+---+---+---+---+---+---+---+
-      //                10
-      //          8            9
-      //       4     3      7     5
-      //      1
-      assertUnit(pq.container.size() == 8);
-      if (pq.container.size() == 8)
+      //                9
+      //          8            7
+      //       4     3      5
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numCopyMove() == 1);   // lift the 5 out of the root
+      assertUnit(Spy::numAssignMove() == 4); // 5 to root, 9 up, 7 up, 5 back in
+      assertUnit(pq.container.size() == 6);
+      if (pq.container.size() == 6)
       {
-         assertUnit(pq.container[0] == int(10));
-         assertUnit(pq.container[1] == int(8));
-         assertUnit(pq.container[2] == int(9));
-         assertUnit(pq.container[3] == int(4));
-         assertUnit(pq.container[4] == int(3));
-         assertUnit(pq.container[5] == int(7));
-         assertUnit(pq.container[6] == int(5));
-         assertUnit(pq.container[7] == int(1));
+         assertUnit(pq.container[0] == Spy(9));
+         assertUnit(pq.container[1] == Spy(8));
+         assertUnit(pq.container[2] == Spy(7));
+         assertUnit(pq.container[5] == Spy(5));
       }
-      // teardown
-      teardownStandardFixture(pq);
-   }
+   }  // teardown
 
-   // push an element to a priority queue which goes up one level
-   void test_push_levelOne()
+   // pop a 4-ary heap compares all four children on a level
+   void test_pop_quaternary()
    {  // setup
-      //  +---+---+---+---+---+---+---+---+---+
-      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |   |   |
-      //  +---+---+---+---+---+---+---+---+---+
-      //                10
-      //          8            9
-      //       4     3      7     5
-      custom::priority_queue <int> pq;
-      setupStandardFixture(pq);
-      int s(6);
+      //                       9
+      //         8         2       3       4
+      //    1  5  6  7
+      custom::priority_queue <Spy, std::less<Spy>, 4> pq;
+      pq.container = {Spy(9), Spy(8), Spy(2), Spy(3), Spy(4), Spy(1), Spy(5), Spy(6), Spy(7)};
+      Spy::reset();
       // exercise
-      pq.push(s);
+      pq.pop();
       // verify
-      //    1   2   3   4   5   6   7   8
-      //  +---+---+---+---+---+---+---+---+---+
-      //  | 10| 8 | 9 | 6 | 3 | 7 | 5 | 4 |   |
-      //  +---+---+---+---+---+---+---+---+---+
-      //                10
-      //          8            9
-      //       6     3      7     5
-      //      4
+      //                       8
+      //         7         2       3       4
+      //    1  5  6
+      assertUnit(Spy::numLessthan() == 7);   // 3 among 8,2,3,4, then 7<8, 2 among 1,5,6, then 7<6
       assertUnit(pq.container.size() == 8);
       if (pq.container.size() == 8)
       {
-         assertUnit(pq.container[0] == int(10));
-         assertUnit(pq.container[1] == int(8));
-         assertUnit(pq.container[2] == int(9));
-         assertUnit(pq.container[3] == int(6));
-         assertUnit(pq.container[4] == int(3));
-         assertUnit(pq.container[5] == int(7));
-         assertUnit(pq.container[6] == int(5));
-         assertUnit(pq.container[7] == int(4));
+         assertUnit(pq.container[0] == Spy(8));
+         assertUnit(pq.container[1] == Spy(7));
+         assertUnit(pq.container[2] == Spy(2));
+         assertUnit(pq.container[3] == Spy(3));
+         assertUnit(pq.container[4] == Spy(4));
+         assertUnit(pq.container[5] == Spy(1));
+         assertUnit(pq.container[6] == Spy(5));
+         assertUnit(pq.container[7] == Spy(6));
       }
-      // teardown
-      teardownStandardFixture(pq);
-   }   
-   
-   // push an element to a priorty queue that goes up two levels
-   void test_push_levelTwo()
+   }  // teardown
+
+   // pop an 8-ary heap until it is empty
+   void test_pop_octonary()
    {  // setup
-      //  +---+---+---+---+---+---+---+---+---+
-      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |   |   |
-      //  +---+---+---+---+---+---+---+---+---+
-      //                10
-      //          8            9
-      //       4     3      7     5
-      custom::priority_queue <int> pq;
-      setupStandardFixture(pq);
-      int s(9);
+      std::initializer_list<int> il{int(12), int(3), int(19), int(7), int(0), int(15), int(4),
+                                    int(11), int(8), int(16), int(1), int(13), int(5), int(18),
+                                    int(9), int(2), int(14), int(6), int(17), int(10)};
+      custom::priority_queue <int, std::less<int>, 8> pq(il.begin(), il.end());
+      bool inOrder = true;
       // exercise
-      pq.push(s);
-      // verify
-      //    1   2   3   4   5   6   7   8
-      //  +---+---+---+---+---+---+---+---+---+
-      //  | 10| 9 | 9 | 8 | 3 | 7 | 5 | 4 |   |
-      //  +---+---+---+---+---+---+---+---+---+
-      //                10
-      //          9            9
-      //       8     3      7     5
-      //      4
-      assertUnit(pq.container.size() == 8);
-      if (pq.container.size() == 8)
+      for (int expected = 19; expected >= 0; expected--)
       {
-         assertUnit(pq.container[0] == int(10));
-         assertUnit(pq.container[1] == int(9));
-         assertUnit(pq.container[2] == int(9));
-         assertUnit(pq.container[3] == int(8));
-         assertUnit(pq.container[4] == int(3));
-         assertUnit(pq.container[5] == int(7));
-         assertUnit(pq.container[6] == int(5));
-         assertUnit(pq.container[7] == int(4));
+         inOrder = inOrder && pq.top() == expected;
+         pq.pop();
       }
-      // teardown
-      teardownStandardFixture(pq);
-   }
+      // verify
+      assertUnit(inOrder);
+      assertEmptyFixture(pq);
+   }  // teardown
 
-   // push an element to the top of a priority queue
-   void test_push_levelThree()
+   // pop the standard fixture bottom up: same heap, fewer comparisons
+   void test_pop_bottomUpStandard()
    {  // setup
-      //  +---+---+---+---+---+---+---+---+---+
-      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |   |   |
-      //  +---+---+---+---+---+---+---+---+---+
-      //                10
-      //          8            9
-      //       4     3      7     5
-      custom::priority_queue <int> pq;
-      setupStandardFixture(pq);
-      int s(11);
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <Spy, std::less<Spy>, 2, custom::pop_bottom_up> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9), Spy(4), Spy(3), Spy(7), Spy(5)};
+      Spy::reset();
       // exercise
-      pq.push(s);
+      pq.pop();
       // verify
-      //    1   2   3   4   5   6   7   8
-      //  +---+---+---+---+---+---+---+---+---+
-      //  | 11| 10| 9 | 8 | 3 | 7 | 5 | 4 |   |
-      //  +---+---+---+---+---+---+---+---+---+
-      //                11
-      //          10            9
-      //       8     3      7     5
-      //      4
-      assertUnit(pq.container.size() == 8);
-      if (pq.container.size() == 8)
-      {
+      //                9
+      //          8            7
+      //       4     3      5
+      assertUnit(Spy::numLessthan() == 2);   // 8 against 9, then 7 against 5
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(pq.container.size() == 6);
+      if (pq.container.size() == 6)
+      {
+         assertUnit(pq.container[0] == Spy(9));
+         assertUnit(pq.container[1] == Spy(8));
+         assertUnit(pq.container[2] == Spy(7));
+         assertUnit(pq.container[3] == Spy(4));
+         assertUnit(pq.container[4] == Spy(3));
+         assertUnit(pq.container[5] == Spy(5));
+      }
+   }  // teardown
+
+   // pop a deep heap bottom up: about one comparison per level
+   void test_pop_bottomUpDeep()
+   {  // setup
+      //   63 items, 6 levels
+      custom::vector <Spy> v;
+      for (int i = 0; i < 63; i++)
+         v.push_back(Spy((i * 37) % 63));
+      custom::priority_queue <Spy, std::less<Spy>, 2, custom::pop_bottom_up> pq(std::move(v));
+      bool inOrder = true;
+      int maxLessthan = 0;
+      // exercise
+      for (int expected = 62; expected >= 0; expected--)
+      {
+         inOrder = inOrder && pq.top().get() == expected;
+         Spy::reset();
+         pq.pop();
+         if (Spy::numLessthan() > maxLessthan)
+            maxLessthan = Spy::numLessthan();
+      }
+      // verify
+      assertUnit(inOrder);
+      assertUnit(maxLessthan <= 5 + 2);      // log2(63) down, a couple back up
+      assertUnit(pq.container.size() == 0);
+   }  // teardown
+
+   /***************************************
+    * POP VALUE
+    ***************************************/
+
+   // pop_value of an empty priority queue
+   void test_popValue_empty()
+   {  // setup
+      custom::priority_queue <int> pq;
+      int value(99);
+      // exercise
+      try
+      {
+         value = pq.pop_value();
+         // verify
+         assertUnit(false);
+      }
+      catch (const char* s)
+      {
+         assertUnit(std::string(s) == std::string("std:out_of_range"));
+      }
+      assertUnit(value == int(99));
+      assertEmptyFixture(pq);
+   }  // teardown
+
+   // pop_value from the standard fixture
+   void test_popValue_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // exercise
+      int value = pq.pop_value();
+      // verify
+      //                9
+      //          8            7
+      //       4     3      5
+      assertUnit(value == int(10));
+      assertUnit(pq.container.size() == 6);
+      if (pq.container.size() == 6)
+      {
+         assertUnit(pq.container[0] == int(9));
+         assertUnit(pq.container[1] == int(8));
+         assertUnit(pq.container[2] == int(7));
+         assertUnit(pq.container[3] == int(4));
+         assertUnit(pq.container[4] == int(3));
+         assertUnit(pq.container[5] == int(5));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // pop_value moves the top out rather than copying it
+   void test_popValue_spy()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9), Spy(4), Spy(3), Spy(7), Spy(5)};
+      Spy::reset();
+      // exercise
+      Spy value = pq.pop_value();
+      // verify
+      assertUnit(value.get() == 10);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(pq.container.size() == 6);
+      if (pq.container.size() == 6)
+         assertUnit(pq.container[0].get() == 9);
+   }  // teardown
+
+   /***************************************
+    * TRY POP
+    ***************************************/
+
+   // try_pop of an empty priority queue
+   void test_tryPop_empty()
+   {  // setup
+      custom::priority_queue <int> pq;
+      int value(99);
+      // exercise
+      bool popped = pq.try_pop(value);
+      // verify
+      assertUnit(popped == false);
+      assertUnit(value == int(99));
+      assertEmptyFixture(pq);
+   }  // teardown
+
+   // try_pop from the standard fixture
+   void test_tryPop_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      int value(99);
+      // exercise
+      bool popped = pq.try_pop(value);
+      // verify
+      //                9
+      //          8            7
+      //       4     3      5
+      assertUnit(popped == true);
+      assertUnit(value == int(10));
+      assertUnit(pq.container.size() == 6);
+      if (pq.container.size() == 6)
+      {
+         assertUnit(pq.container[0] == int(9));
+         assertUnit(pq.container[2] == int(7));
+         assertUnit(pq.container[5] == int(5));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // try_pop moves the top out rather than copying it
+   void test_tryPop_spy()
+   {  // setup
+      //               10
+      //         8
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8)};
+      Spy value;
+      Spy::reset();
+      // exercise
+      bool popped = pq.try_pop(value);
+      // verify
+      assertUnit(popped == true);
+      assertUnit(value.get() == 10);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(pq.container.size() == 1);
+      if (pq.container.size() == 1)
+         assertUnit(pq.container[0].get() == 8);
+   }  // teardown
+
+   /***************************************
+    * REPLACE TOP
+    ***************************************/
+
+   // replace_top of an empty priority queue
+   void test_replaceTop_empty()
+   {  // setup
+      custom::priority_queue <int> pq;
+      // exercise
+      try
+      {
+         pq.replace_top(int(50));
+         // verify
+         assertUnit(false);
+      }
+      catch (const char* s)
+      {
+         assertUnit(std::string(s) == std::string("std:out_of_range"));
+      }
+      assertEmptyFixture(pq);
+   }  // teardown
+
+   // replace the 10 with a 6 in the standard fixture
+   void test_replaceTop_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // exercise
+      int value = pq.replace_top(int(6));
+      // verify
+      //               9
+      //         8            7
+      //      4     3      6     5
+      assertUnit(value == int(10));
+      assertUnit(pq.container.size() == 7);
+      if (pq.container.size() == 7)
+      {
+         assertUnit(pq.container[0] == int(9));
+         assertUnit(pq.container[1] == int(8));
+         assertUnit(pq.container[2] == int(7));
+         assertUnit(pq.container[3] == int(4));
+         assertUnit(pq.container[4] == int(3));
+         assertUnit(pq.container[5] == int(6));
+         assertUnit(pq.container[6] == int(5));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // replace_top costs one percolate down: fewer comparisons than pop then push
+   void test_replaceTop_spy()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9), Spy(4), Spy(3), Spy(7), Spy(5)};
+      Spy s(6);
+      Spy::reset();
+      // exercise
+      Spy value = pq.replace_top(std::move(s));
+      // verify
+      //               9
+      //         8            7
+      //      4     3      6     5
+      assertUnit(value.get() == 10);
+      assertUnit(Spy::numLessthan() == 4);   // 8 vs 9, 6 vs 9, 7 vs 5, 6 vs 7
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(pq.container.size() == 7);
+      if (pq.container.size() == 7)
+      {
+         assertUnit(pq.container[0].get() == 9);
+         assertUnit(pq.container[2].get() == 7);
+         assertUnit(pq.container[5].get() == 6);
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH POP
+    ***************************************/
+
+   // push_pop on an empty priority queue hands the item back
+   void test_pushPop_empty()
+   {  // setup
+      custom::priority_queue <int> pq;
+      // exercise
+      int value = pq.push_pop(int(50));
+      // verify
+      assertUnit(value == int(50));
+      assertEmptyFixture(pq);
+   }  // teardown
+
+   // push_pop an item that would be the new top leaves the heap alone
+   void test_pushPop_newTop()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9), Spy(4), Spy(3), Spy(7), Spy(5)};
+      Spy s(11);
+      Spy::reset();
+      // exercise
+      Spy value = pq.push_pop(std::move(s));
+      // verify
+      assertUnit(value.get() == 11);
+      assertUnit(Spy::numLessthan() == 1);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(pq.container.size() == 7);
+      if (pq.container.size() == 7)
+         assertUnit(pq.container[0].get() == 10);
+   }  // teardown
+
+   // push_pop a 6 onto the standard fixture pops the 10
+   void test_pushPop_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // exercise
+      int value = pq.push_pop(int(6));
+      // verify
+      //               9
+      //         8            7
+      //      4     3      6     5
+      assertUnit(value == int(10));
+      assertUnit(pq.container.size() == 7);
+      if (pq.container.size() == 7)
+      {
+         assertUnit(pq.container[0] == int(9));
+         assertUnit(pq.container[2] == int(7));
+         assertUnit(pq.container[5] == int(6));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   /***************************************
+    * POP N
+    ***************************************/
+
+   // pop_n from an empty priority queue writes nothing
+   void test_popN_empty()
+   {  // setup
+      custom::priority_queue <int> pq;
+      std::vector<int> values;
+      // exercise
+      pq.pop_n(5, std::back_inserter(values));
+      // verify
+      assertUnit(values.empty());
+      assertEmptyFixture(pq);
+   }  // teardown
+
+   // pop_n more than the standard fixture holds takes them all
+   void test_popN_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      int values[10] = {};
+      // exercise
+      int * pEnd = pq.pop_n(10, values);
+      // verify
+      assertUnit(pEnd == values + 7);
+      assertUnit(values[0] == int(10));
+      assertUnit(values[1] == int(9));
+      assertUnit(values[2] == int(8));
+      assertUnit(values[3] == int(7));
+      assertUnit(values[4] == int(5));
+      assertUnit(values[5] == int(4));
+      assertUnit(values[6] == int(3));
+      assertEmptyFixture(pq);
+   }  // teardown
+
+   // pop_n a few items from a big heap pops them one at a time
+   void test_popN_few()
+   {  // setup
+      //   0..999 in a heap
+      custom::vector <int> v;
+      for (int i = 0; i < 1000; i++)
+         v.push_back((i * 337) % 1000);
+      custom::priority_queue <int> pq(std::move(v));
+      std::vector<int> values;
+      // exercise
+      pq.pop_n(50, std::back_inserter(values));
+      // verify
+      assertUnit(values.size() == 50);
+      bool inOrder = values.size() == 50;
+      for (size_t i = 0; inOrder && i < values.size(); i++)
+         inOrder = values[i] == int(999 - i);
+      assertUnit(inOrder);
+      assertUnit(pq.container.size() == 950);
+      assertUnit(isHeap(pq));
+      bool restInOrder = true;
+      for (int expected = 949; expected >= 0; expected--)
+      {
+         restInOrder = restInOrder && pq.top() == expected;
+         pq.pop();
+      }
+      assertUnit(restInOrder);
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // pop_n a big share of the heap selects them and rebuilds the rest
+   void test_popN_select()
+   {  // setup
+      //   0..999 in a heap
+      custom::vector <int> v;
+      for (int i = 0; i < 1000; i++)
+         v.push_back((i * 337) % 1000);
+      custom::priority_queue <int> pq(std::move(v));
+      std::vector<int> values;
+      // exercise
+      pq.pop_n(400, std::back_inserter(values));
+      // verify
+      assertUnit(values.size() == 400);
+      bool inOrder = values.size() == 400;
+      for (size_t i = 0; inOrder && i < values.size(); i++)
+         inOrder = values[i] == int(999 - i);
+      assertUnit(inOrder);
+      assertUnit(pq.container.size() == 600);
+      assertUnit(isHeap(pq));
+      bool restInOrder = true;
+      for (int expected = 599; expected >= 0; expected--)
+      {
+         restInOrder = restInOrder && pq.top() == expected;
+         pq.pop();
+      }
+      assertUnit(restInOrder);
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // pop_n moves the items out rather than copying them
+   void test_popN_spy()
+   {  // setup
+      //   0..99 in a heap
+      custom::vector <Spy> v;
+      for (int i = 0; i < 100; i++)
+         v.push_back(Spy((i * 37) % 100));
+      custom::priority_queue <Spy> pq(std::move(v));
+      Spy values[10];
+      Spy::reset();
+      // exercise
+      pq.pop_n(10, values);
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(values[0].get() == 99);
+      assertUnit(values[9].get() == 90);
+      assertUnit(pq.container.size() == 90);
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   /***************************************
+    * ERASE IF and RETAIN IF
+    ***************************************/
+
+   // erase_if on an empty heap removes nothing
+   void test_eraseIf_empty()
+   {  // setup
+      custom::priority_queue <int> pq;
+      // exercise
+      size_t numRemoved = pq.erase_if([](int) { return true; });
+      // verify
+      assertUnit(numRemoved == 0);
+      assertUnit(pq.empty());
+   }  // teardown
+
+   // erase_if that matches nothing leaves the heap as it was
+   void test_eraseIf_none()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // exercise
+      size_t numRemoved = pq.erase_if([](int value) { return value > 10; });
+      // verify
+      assertUnit(numRemoved == 0);
+      assertStandardFixture(pq);
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // erase_if the odd items, the root among them
+   void test_eraseIf_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // exercise
+      size_t numRemoved = pq.erase_if([](int value) { return value % 2 == 1; });
+      // verify
+      //          10
+      //      8       4
+      assertUnit(numRemoved == 4);
+      assertUnit(pq.container.size() == 3);
+      assertUnit(isHeap(pq));
+      if (pq.container.size() == 3)
+      {
+         assertUnit(pq.container[0] == int(10));
+         assertUnit(pq.container[1] == int(8));
+         assertUnit(pq.container[2] == int(4));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // erase_if every item
+   void test_eraseIf_all()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // exercise
+      size_t numRemoved = pq.erase_if([](int) { return true; });
+      // verify
+      assertUnit(numRemoved == 7);
+      assertUnit(pq.empty());
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // erase_if calls pred once per item, moves rather than copies,
+   // and makes at most one comparison per move of a linear rebuild
+   void test_eraseIf_spy()
+   {  // setup
+      //   0..99 in a heap
+      custom::vector <Spy> v;
+      for (int i = 0; i < 100; i++)
+         v.push_back(Spy((i * 37) % 100));
+      custom::priority_queue <Spy> pq(std::move(v));
+      int numCalls = 0;
+      Spy::reset();
+      // exercise
+      size_t numRemoved = pq.erase_if([&numCalls](const Spy & spy)
+      {
+         numCalls++;
+         return spy.get() % 10 == 0;
+      });
+      // verify
+      assertUnit(numRemoved == 10);
+      assertUnit(numCalls == 100);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(Spy::numLessthan() <= 2 * 90);
+      assertUnit(pq.container.size() == 90);
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   // retain_if keeps the even items
+   void test_retainIf_standard()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // exercise
+      size_t numRemoved = pq.retain_if([](int value) { return value % 2 == 0; });
+      // verify
+      assertUnit(numRemoved == 4);
+      assertUnit(pq.container.size() == 3);
+      assertUnit(isHeap(pq));
+      assertUnit(pq.top() == 10);
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   /***************************************
+    * LAYOUT BLOCKED
+    ***************************************/
+
+   // a 64 byte block of ints holds two subtrees of 7 in 16 slots, and
+   // the bottom nodes lead to other blocks
+   void test_layoutBlocked_navigate()
+   {  // setup
+      typedef custom::layout_blocked<64>::tree<int, 2> tree;
+      bool isConsistent = true;
+      // exercise
+      for (size_t num = 2; num <= 5000; num++)
+      {
+         size_t indexHeap = tree::indexOf(num);
+         size_t indexParent = tree::indexParent(indexHeap);
+         size_t indexFirst = tree::indexFirstChild(indexParent);
+         isConsistent = isConsistent && indexParent < indexHeap &&
+                        (indexHeap == indexFirst || indexHeap == indexFirst + 1) &&
+                        tree::indexPrevious(indexHeap) == tree::indexOf(num - 1);
+      }
+      // verify
+      assertUnit(isConsistent);
+      assertUnit(tree::numSlots == 16);
+      assertUnit(tree::numBlock == 14);
+      assertUnit(tree::indexOf(15) == 15);
+      assertUnit(tree::indexOf(16) == 18);
+      assertUnit(tree::indexFirstChild(1) == 2);
+      assertUnit(tree::indexFirstChild(4) == 8);
+      assertUnit(tree::indexFirstChild(8) == 18);
+      assertUnit(tree::indexFirstChild(15) == 130);
+      assertUnit(tree::indexParent(130) == 15);
+      assertUnit(tree::indexParent(18) == 8);
+   }  // teardown
+
+   // heapify every size, including those that end on a block root
+   void test_layoutBlocked_heapify()
+   {  // setup
+      bool isEveryHeap = true;
+      // exercise
+      for (int num = 1; num <= 300; num++)
+      {
+         custom::vector <int> v;
+         for (int i = 0; i < num; i++)
+            v.push_back(i);
+         custom::priority_queue <int, std::less<int>, 2, custom::pop_top_down,
+                                 custom::layout_blocked<64> > pq(std::move(v));
+         isEveryHeap = isEveryHeap && isHeap(pq) && pq.top() == num - 1;
+      }
+      // verify
+      assertUnit(isEveryHeap);
+   }  // teardown
+
+   // push and pop give the same order as the flat layout
+   void test_layoutBlocked_pushPop()
+   {  // setup
+      custom::priority_queue <int> pqFlat;
+      custom::priority_queue <int, std::less<int>, 2, custom::pop_bottom_up,
+                              custom::layout_blocked<64> > pqBlocked;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         pqFlat.push((i * 337) % 1009);
+         pqBlocked.push((i * 337) % 1009);
+      }
+      // verify
+      assertUnit(isHeap(pqBlocked));
+      bool isSameOrder = true;
+      while (!pqFlat.empty())
+      {
+         isSameOrder = isSameOrder && pqBlocked.top() == pqFlat.top();
+         pqFlat.pop();
+         pqBlocked.pop();
+      }
+      assertUnit(isSameOrder);
+      assertUnit(pqBlocked.empty());
+   }  // teardown
+
+   // push_range, erase_if and pop_n keep the blocked heap a heap
+   void test_layoutBlocked_bulk()
+   {  // setup
+      custom::priority_queue <int, std::less<int>, 2, custom::pop_top_down,
+                              custom::layout_blocked<64> > pq;
+      for (int i = 0; i < 100; i++)
+         pq.push(i);
+      custom::vector <int> batch;
+      for (int i = 100; i < 1000; i++)
+         batch.push_back((i * 337) % 900 + 100);
+      std::vector <int> values;
+      // exercise
+      pq.push_range(std::move(batch));
+      bool isHeapAfterPush = isHeap(pq);
+      size_t numRemoved = pq.erase_if([](int value) { return value % 3 == 0; });
+      bool isHeapAfterErase = isHeap(pq);
+      pq.pop_n(10, std::back_inserter(values));
+      // verify
+      assertUnit(isHeapAfterPush);
+      assertUnit(isHeapAfterErase);
+      assertUnit(isHeap(pq));
+      assertUnit(numRemoved == 334);
+      assertUnit(pq.size() == 1000 - 334 - 10);
+      assertUnit(values.size() == 10 && values[0] == 998 && values[9] == 985);
+   }  // teardown
+
+   // every block starts on a 64 or 4096 byte boundary, a block apart
+   void test_layoutBlocked_aligned()
+   {  // setup
+      custom::priority_queue <int, std::less<int>, 2, custom::pop_top_down,
+                              custom::layout_blocked<64> > pqLine;
+      custom::priority_queue <int, std::less<int>, 2, custom::pop_top_down,
+                              custom::layout_blocked<4096> > pqPage;
+      // exercise
+      for (int i = 0; i < 3000; i++)
+      {
+         pqLine.push((i * 337) % 1009);
+         pqPage.push((i * 337) % 1009);
+      }
+      // verify
+      assertUnit(isBlockAligned(pqLine, 64));
+      assertUnit(isBlockAligned(pqPage, 4096));
+      assertUnit(isHeap(pqLine) && isHeap(pqPage));
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   void test_push_empty()
+   {  // setup
+      custom::priority_queue <int> pq;
+      int s(10);
+      // exercise
+      pq.push(s);
+      // verify
+      //  +----+
+      //  | 10 |
+      //  +----+
+      assertUnit(pq.container.size() == 1);
+      if (pq.container.size() == 1)
+         assertUnit(pq.container[0] == int(10));
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // push an element to the bottom of a priority queue - level zero
+   void test_push_levelZero()
+   {  // setup
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |   |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //                10
+      //          8            9
+      //       4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      int s(1);
+      // exercise
+      pq.push(s);
+      // verify
+      //    1   2   3   4   5   6   7   8
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 | 1 |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //                10
+      //          8            9
+      //       4     3      7     5
+      //      1
+      assertUnit(pq.container.size() == 8);
+      if (pq.container.size() == 8)
+      {
+         assertUnit(pq.container[0] == int(10));
+         assertUnit(pq.container[1] == int(8));
+         assertUnit(pq.container[2] == int(9));
+         assertUnit(pq.container[3] == int(4));
+         assertUnit(pq.container[4] == int(3));
+         assertUnit(pq.container[5] == int(7));
+         assertUnit(pq.container[6] == int(5));
+         assertUnit(pq.container[7] == int(1));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // push an element to a priority queue which goes up one level
+   void test_push_levelOne()
+   {  // setup
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |   |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //                10
+      //          8            9
+      //       4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      int s(6);
+      // exercise
+      pq.push(s);
+      // verify
+      //    1   2   3   4   5   6   7   8
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 6 | 3 | 7 | 5 | 4 |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //                10
+      //          8            9
+      //       6     3      7     5
+      //      4
+      assertUnit(pq.container.size() == 8);
+      if (pq.container.size() == 8)
+      {
+         assertUnit(pq.container[0] == int(10));
+         assertUnit(pq.container[1] == int(8));
+         assertUnit(pq.container[2] == int(9));
+         assertUnit(pq.container[3] == int(6));
+         assertUnit(pq.container[4] == int(3));
+         assertUnit(pq.container[5] == int(7));
+         assertUnit(pq.container[6] == int(5));
+         assertUnit(pq.container[7] == int(4));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }   
+   
+   // push an element to a priorty queue that goes up two levels
+   void test_push_levelTwo()
+   {  // setup
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |   |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //                10
+      //          8            9
+      //       4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      int s(9);
+      // exercise
+      pq.push(s);
+      // verify
+      //    1   2   3   4   5   6   7   8
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 10| 9 | 9 | 8 | 3 | 7 | 5 | 4 |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //                10
+      //          9            9
+      //       8     3      7     5
+      //      4
+      assertUnit(pq.container.size() == 8);
+      if (pq.container.size() == 8)
+      {
+         assertUnit(pq.container[0] == int(10));
+         assertUnit(pq.container[1] == int(9));
+         assertUnit(pq.container[2] == int(9));
+         assertUnit(pq.container[3] == int(8));
+         assertUnit(pq.container[4] == int(3));
+         assertUnit(pq.container[5] == int(7));
+         assertUnit(pq.container[6] == int(5));
+         assertUnit(pq.container[7] == int(4));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // push an element to the top of a priority queue
+   void test_push_levelThree()
+   {  // setup
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 10| 8 | 9 | 4 | 3 | 7 | 5 |   |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //                10
+      //          8            9
+      //       4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      int s(11);
+      // exercise
+      pq.push(s);
+      // verify
+      //    1   2   3   4   5   6   7   8
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 11| 10| 9 | 8 | 3 | 7 | 5 | 4 |   |
+      //  +---+---+---+---+---+---+---+---+---+
+      //                11
+      //          10            9
+      //       8     3      7     5
+      //      4
+      assertUnit(pq.container.size() == 8);
+      if (pq.container.size() == 8)
+      {
          assertUnit(pq.container[0] == int(11));
          assertUnit(pq.container[1] == int(10));
          assertUnit(pq.container[2] == int(9));
@@ -1108,6 +2175,423 @@ public:
       teardownStandardFixture(pq);
    }
 
+   // push onto a min heap so the smallest rises to the top
+   void test_push_greater()
+   {  // setup
+      custom::priority_queue <int, std::greater<int>> pq;
+      // exercise
+      pq.push(int(10));
+      pq.push(int(8));
+      pq.push(int(9));
+      pq.push(int(4));
+      // verify
+      //    1   2   3   4
+      //  +---+---+---+---+
+      //  | 4 | 8 | 9 | 10|
+      //  +---+---+---+---+
+      //                4
+      //          8            9
+      //       10
+      assertUnit(pq.container.size() == 4);
+      if (pq.container.size() == 4)
+      {
+         assertUnit(pq.container[0] == int(4));
+         assertUnit(pq.container[1] == int(8));
+         assertUnit(pq.container[2] == int(9));
+         assertUnit(pq.container[3] == int(10));
+      }
+      assertUnit(pq.top() == int(4));
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // push onto a leaf costs one comparison against the parent
+   void test_push_spyLevelZero()
+   {  // setup
+      //                10
+      //          8            9
+      //       4     3      7     5
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9), Spy(4), Spy(3), Spy(7), Spy(5)};
+      pq.container.reserve(9);
+      Spy s(1);
+      Spy::reset();
+      // exercise
+      pq.push(s);
+      // verify
+      //                10
+      //          8            9
+      //       4     3      7     5
+      //      1
+      assertUnit(Spy::numLessthan() == 1);
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(pq.container.size() == 8);
+      if (pq.container.size() == 8)
+         assertUnit(pq.container[7] == Spy(1));
+   }  // teardown
+
+   // push an item up two levels: one comparison per level, no swaps
+   void test_push_spyLevelTwo()
+   {  // setup
+      //                10
+      //          8            9
+      //       4     3      7     5
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9), Spy(4), Spy(3), Spy(7), Spy(5)};
+      pq.container.reserve(9);
+      Spy s(9);
+      Spy::reset();
+      // exercise
+      pq.push(std::move(s));
+      // verify
+      //                10
+      //          9            9
+      //       8     3      7     5
+      //      4
+      assertUnit(Spy::numLessthan() == 3);   // against 4, 8, and 10
+      assertUnit(Spy::numSwap() == 0);
+      assertUnit(Spy::numCopyMove() == 1);   // lift the 9 out
+      assertUnit(Spy::numAssignMove() == 4); // push_back, 4 down, 8 down, 9 in
+      assertUnit(pq.container.size() == 8);
+      if (pq.container.size() == 8)
+      {
+         assertUnit(pq.container[0] == Spy(10));
+         assertUnit(pq.container[1] == Spy(9));
+         assertUnit(pq.container[3] == Spy(8));
+         assertUnit(pq.container[7] == Spy(4));
+      }
+   }  // teardown
+
+   // push onto a 4-ary heap: the root has children 2..5, node 2 has 6..9
+   void test_push_quaternary()
+   {  // setup
+      custom::priority_queue <int, std::less<int>, 4> pq;
+      // exercise
+      for (int i = 1; i <= 9; i++)
+         pq.push(i);
+      // verify
+      //    1   2   3   4   5   6   7   8   9
+      //  +---+---+---+---+---+---+---+---+---+
+      //  | 9 | 8 | 2 | 3 | 4 | 1 | 5 | 6 | 7 |
+      //  +---+---+---+---+---+---+---+---+---+
+      //                       9
+      //         8         2       3       4
+      //    1  5  6  7
+      assertUnit(pq.container.size() == 9);
+      if (pq.container.size() == 9)
+      {
+         assertUnit(pq.container[0] == int(9));
+         assertUnit(pq.container[1] == int(8));
+         assertUnit(pq.container[2] == int(2));
+         assertUnit(pq.container[3] == int(3));
+         assertUnit(pq.container[4] == int(4));
+         assertUnit(pq.container[5] == int(1));
+         assertUnit(pq.container[6] == int(5));
+         assertUnit(pq.container[7] == int(6));
+         assertUnit(pq.container[8] == int(7));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   /***************************************
+    * EMPLACE
+    ***************************************/
+
+   // emplace onto a leaf builds the item in place: no copy or move
+   void test_emplace_levelZero()
+   {  // setup
+      //                10
+      //          8            9
+      //       4     3      7     5
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9), Spy(4), Spy(3), Spy(7), Spy(5)};
+      pq.container.reserve(9);
+      Spy::reset();
+      // exercise
+      pq.emplace(1);
+      // verify
+      //                10
+      //          8            9
+      //       4     3      7     5
+      //      1
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(pq.container.size() == 8);
+      if (pq.container.size() == 8)
+         assertUnit(pq.container[7] == Spy(1));
+   }  // teardown
+
+   // emplace an item that goes up two levels
+   void test_emplace_levelTwo()
+   {  // setup
+      //                10
+      //          8            9
+      //       4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      // exercise
+      pq.emplace(9);
+      // verify
+      //                10
+      //          9            9
+      //       8     3      7     5
+      //      4
+      assertUnit(pq.container.size() == 8);
+      if (pq.container.size() == 8)
+      {
+         assertUnit(pq.container[0] == int(10));
+         assertUnit(pq.container[1] == int(9));
+         assertUnit(pq.container[2] == int(9));
+         assertUnit(pq.container[3] == int(8));
+         assertUnit(pq.container[7] == int(4));
+      }
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   /***************************************
+    * PUSH RANGE
+    ***************************************/
+
+   // push_range of nothing changes nothing
+   void test_pushRange_empty()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      std::initializer_list<int> il;
+      // exercise
+      pq.push_range(il.begin(), il.end());
+      // verify
+      assertStandardFixture(pq);
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // push_range a batch that is small next to the heap: percolate each up
+   void test_pushRange_small()
+   {  // setup
+      //   7000 items, then 3 more
+      custom::priority_queue <int> pq;
+      for (int i = 0; i < 7000; i++)
+         pq.container.push_back((i * 7919) % 7000);
+      pq.heapify();
+      std::initializer_list<int> il{int(7000), int(-1), int(3500)};
+      // exercise
+      pq.push_range(il.begin(), il.end());
+      // verify
+      assertUnit(pq.container.size() == 7003);
+      assertUnit(pq.container[0] == int(7000));
+      assertUnit(isHeap(pq));
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // push_range a batch that is big next to the heap: rebuild
+   void test_pushRange_large()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      std::initializer_list<int> il{int(1), int(12), int(6), int(11), int(2), int(0), int(13), int(14)};
+      // exercise
+      pq.push_range(il.begin(), il.end());
+      // verify
+      assertUnit(pq.container.size() == 15);
+      assertUnit(pq.container.capacity() == 18);
+      assertUnit(isHeap(pq));
+      bool inOrder = true;
+      for (int expected : {14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0})
+      {
+         inOrder = inOrder && pq.top() == expected;
+         pq.pop();
+      }
+      assertUnit(inOrder);
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // push_range a vector moves the items: no copies
+   void test_pushRange_move()
+   {  // setup
+      //               10
+      //         8            9
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9)};
+      custom::vector <Spy> v{Spy(11), Spy(4), Spy(12)};
+      Spy::reset();
+      // exercise
+      pq.push_range(std::move(v));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(v.size() == 0);
+      assertUnit(pq.container.size() == 6);
+      if (pq.container.size() == 6)
+         assertUnit(pq.container[0].get() == 12);
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   /***************************************
+    * MERGE
+    ***************************************/
+
+   // merge an empty heap changes nothing
+   void test_merge_empty()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      setupStandardFixture(pq);
+      custom::priority_queue <int> pqOther;
+      // exercise
+      pq.merge(std::move(pqOther));
+      // verify
+      assertStandardFixture(pq);
+      assertUnit(pqOther.empty());
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // merge a bigger heap into an empty one: take its buffer
+   void test_merge_steal()
+   {  // setup
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      custom::priority_queue <int> pqOther;
+      setupStandardFixture(pqOther);
+      int * pData = pqOther.container.data;
+      // exercise
+      pq.merge(std::move(pqOther));
+      // verify
+      assertUnit(pq.container.data == pData);
+      assertStandardFixture(pq);
+      assertUnit(pqOther.empty());
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // merge two heaps: every item, still a heap
+   void test_merge_standard()
+   {  // setup
+      //         12
+      //      1      6
+      //               10
+      //         8            9
+      //      4     3      7     5
+      custom::priority_queue <int> pq;
+      pq.container = {int(12), int(1), int(6)};
+      custom::priority_queue <int> pqOther;
+      setupStandardFixture(pqOther);
+      // exercise
+      pq.merge(std::move(pqOther));
+      // verify
+      assertUnit(pqOther.empty());
+      assertUnit(pq.container.size() == 10);
+      assertUnit(isHeap(pq));
+      bool inOrder = true;
+      for (int expected : {12, 10, 9, 8, 7, 6, 5, 4, 3, 1})
+      {
+         inOrder = inOrder && pq.top() == expected;
+         pq.pop();
+      }
+      assertUnit(inOrder);
+      // teardown
+      teardownStandardFixture(pq);
+   }
+
+   // merge moves the smaller heap's items: no copies
+   void test_merge_spy()
+   {  // setup
+      //               10
+      //         8            9
+      //      4
+      //         12
+      //      1      6
+      custom::priority_queue <Spy> pq;
+      pq.container = {Spy(10), Spy(8), Spy(9), Spy(4)};
+      custom::priority_queue <Spy> pqOther;
+      pqOther.container = {Spy(12), Spy(1), Spy(6)};
+      pq.container.reserve(8);
+      Spy::reset();
+      // exercise
+      pq.merge(std::move(pqOther));
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAlloc() == 0);
+      assertUnit(pqOther.empty());
+      assertUnit(pq.container.size() == 7);
+      if (pq.container.size() == 7)
+         assertUnit(pq.container[0].get() == 12);
+      assertUnit(isHeap(pq));
+   }  // teardown
+
+   /***************************************************
+    * COMPARE DIRECTION
+    * A comparator with state: a max heap or a min heap
+    ***************************************************/
+   struct CompareDirection
+   {
+      CompareDirection(bool isMin = false) : isMin(isMin) {}
+      bool operator()(int lhs, int rhs) const { return isMin ? rhs < lhs : lhs < rhs; }
+      bool isMin;
+   };
+
+   /***************************************************
+    * IS HEAP
+    * No item belongs above its parent
+    ***************************************************/
+   template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+   bool isHeap(custom::priority_queue <T, Compare, Arity, PopStrategy, Layout>& pq)
+   {
+      typedef typename custom::priority_queue <T, Compare, Arity, PopStrategy, Layout>::tree tree;
+      for (size_t num = 2; num <= pq.size(); num++)
+      {
+         size_t indexHeap = tree::indexOf(num);
+         if (pq.isLess(pq.indexParent(indexHeap), indexHeap))
+            return false;
+      }
+      return true;
+   }
+
+   /***************************************************
+    * IS BLOCK ALIGNED
+    * Each block of a blocked heap starts on a multiple
+    * of blockBytes, exactly blockBytes after the one
+    * before, with two empty slots ahead of its first
+    * node. The root fills the second of the first block.
+    ***************************************************/
+   template <class T, class Compare, size_t Arity, class PopStrategy, class Layout>
+   bool isBlockAligned(custom::priority_queue <T, Compare, Arity, PopStrategy, Layout>& pq, uintptr_t blockBytes)
+   {
+      typedef typename custom::priority_queue <T, Compare, Arity, PopStrategy, Layout>::tree tree;
+      uintptr_t addressBlocks = reinterpret_cast<uintptr_t>(&pq.containerAt(1)) - sizeof(T);
+      if (addressBlocks % blockBytes != 0)
+         return false;
+      for (size_t block = 0; (block << tree::height) + 2 <= pq.indexBack(); block++)
+      {
+         uintptr_t address = reinterpret_cast<uintptr_t>(&pq.containerAt((block << tree::height) + 2));
+         if (address != addressBlocks + block * blockBytes + 2 * sizeof(T))
+            return false;
+      }
+      return true;
+   }
+
    /***************************************************
     * SETUP STANDARD FIXTURE
     *                 10
@@ -1127,7 +2611,9 @@ public:
    /***************************************************
     * VERIFY EMPTY FIXTURE
     ***************************************************/
-   void assertEmptyFixtureParameters(const custom::priority_queue <int>& pq, int line, const char* function)
+   template <class Compare, size_t Arity, class PopStrategy>
+   void assertEmptyFixtureParameters(const custom::priority_queue <int, Compare, Arity, PopStrategy>& pq,
+                                     int line, const char* function)
    {
       assertIndirect(pq.container.empty());
    }
@@ -1190,7 +2676,8 @@ public:
     *   |   |   |   |   |   |   |   |   |   |   |
     *   +---+---+---+---+---+---+---+---+---+---+
     ***************************************************/
-   void teardownStandardFixture(custom::priority_queue <int>& pq)
+   template <class Compare, size_t Arity, class PopStrategy>
+   void teardownStandardFixture(custom::priority_queue <int, Compare, Arity, PopStrategy>& pq)
    {
       pq.container.empty();
    }
@@ -0,0 +1,336 @@
+/***********************************************************************
+ * Header:
+ *    TEST RADIX HEAP
+ * Summary:
+ *    Unit tests for the radix heap and its keys
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "radix_heap.h"       // class under test
+#include "priority_queue.h"   // the reference it must agree with
+#include "unitTest.h"         // unit test baseclass
+#include "spy.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+
+
+class TestRadixHeap : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Keys
+      test_key_unsigned();
+      test_key_float();
+      test_key_double();
+
+      // Construct
+      test_construct_default();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_buckets();
+      test_push_tooSmall();
+      test_push_negativeZero();
+      test_push_spy();
+
+      // Remove
+      test_pop_standard();
+      test_pop_refill();
+      test_pop_float();
+      test_pop_monotone();
+      test_clear();
+
+      report("RadixHeap");
+   }
+
+   /***************************************
+    * RADIX KEY
+    ***************************************/
+
+   // an unsigned integer is its own bits
+   void test_key_unsigned()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(custom::radix_key<uint32_t>::encode(7u) == 7u);
+      assertUnit(custom::radix_key<uint64_t>::decode(UINT64_MAX) == UINT64_MAX);
+   }  // teardown
+
+   // float bits sort like the floats, and come back unchanged
+   void test_key_float()
+   {  // setup
+      float values[] = { -1e30f, -2.5f, -0.5f, 0.0f, 1e-30f, 0.5f, 2.5f, 1e30f };
+      typedef custom::radix_key<float> key;
+      bool isOrdered = true;
+      bool isSame = true;
+      // exercise
+      for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+      {
+         if (i)
+            isOrdered = isOrdered && key::encode(values[i - 1]) < key::encode(values[i]);
+         isSame = isSame && key::decode(key::encode(values[i])) == values[i];
+      }
+      // verify
+      assertUnit(isOrdered);
+      assertUnit(isSame);
+      assertUnit(key::encode(0.0f) == 0x80000000u);
+      assertUnit(key::encode(-0.0f) == 0x80000000u);
+   }  // teardown
+
+   // the same for a double
+   void test_key_double()
+   {  // setup
+      typedef custom::radix_key<double> key;
+      // exercise
+      // verify
+      assertUnit(key::encode(-3.0) < key::encode(-2.0));
+      assertUnit(key::encode(-2.0) < key::encode(0.0));
+      assertUnit(key::encode(0.0)  < key::encode(0.1));
+      assertUnit(key::encode(0.1)  < key::encode(1e300));
+      assertUnit(key::decode(key::encode(-0.1)) == -0.1);
+   }  // teardown
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::radix_heap <uint32_t, int> heap;
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.size() == 0);
+      assertUnit(heap.last == 0);
+      assertUnit(heap.numBits == 32);
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // top of an empty heap throws
+   void test_top_empty()
+   {  // setup
+      custom::radix_heap <uint32_t, int> heap;
+      // exercise
+      try
+      {
+         heap.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // each key goes in the bucket of its highest bit that differs from last
+   void test_push_buckets()
+   {  // setup
+      custom::radix_heap <uint32_t, int> heap;
+      // exercise
+      heap.push(0u, 10);
+      heap.push(1u, 11);
+      heap.push(6u, 16);
+      heap.push(7u, 17);
+      heap.push(0x80000000u, 99);
+      // verify
+      assertUnit(heap.size() == 5);
+      assertUnit(heap.buckets[0].size() == 1);
+      assertUnit(heap.buckets[1].size() == 1);
+      assertUnit(heap.buckets[3].size() == 2);
+      assertUnit(heap.buckets[32].size() == 1);
+      assertUnit(heap.top_key() == 0u);
+      assertUnit(heap.top() == 10);
+   }  // teardown
+
+   // a key below the last one on top throws, and changes nothing
+   void test_push_tooSmall()
+   {  // setup
+      custom::radix_heap <uint32_t, int> heap;
+      heap.push(5u, 5);
+      heap.push(9u, 9);
+      heap.pop();
+      assertUnit(heap.top_key() == 9u);
+      // exercise
+      try
+      {
+         heap.push(8u, 8);
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("std:invalid_argument"));
+      }
+      assertUnit(heap.size() == 1);
+      heap.push(9u, 90);
+      assertUnit(heap.size() == 2);
+   }  // teardown
+
+   // -0 equals the +0 on top, so it is not too small
+   void test_push_negativeZero()
+   {  // setup
+      custom::radix_heap <float, int> heap;
+      heap.push(0.0f, 1);
+      heap.push(1.0f, 2);
+      heap.pop();
+      // exercise
+      heap.push(-0.0f, 3);
+      // verify
+      assertUnit(heap.size() == 2);
+      assertUnit(heap.top_key() == 0.0f);
+      assertUnit(heap.pop_value() == 3);
+      assertUnit(heap.pop_value() == 2);
+   }  // teardown
+
+   // an rvalue is moved in, and moved out again by pop_value
+   void test_push_spy()
+   {  // setup
+      custom::radix_heap <uint64_t, Spy> heap;
+      for (uint64_t key = 0; key < 20; key++)
+         heap.push((key * 7) % 20 + 100, Spy(int(key)));
+      Spy::reset();
+      // exercise
+      heap.push(uint64_t(100), Spy(50));
+      Spy value = heap.pop_value();
+      // verify
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(value.get() == 50);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop hands the items out smallest first
+   void test_pop_standard()
+   {  // setup
+      custom::radix_heap <uint32_t, int> heap;
+      for (uint32_t key : { 7u, 5u, 9u, 1u, 3u, 4u, 8u })
+         heap.push(key, int(key) * 10);
+      std::string s;
+      // exercise
+      while (!heap.empty())
+      {
+         s += std::to_string(heap.top_key()) + ":";
+         s += std::to_string(heap.pop_value()) + " ";
+      }
+      // verify
+      assertUnit(s == std::string("1:10 3:30 4:40 5:50 7:70 8:80 9:90 "));
+      heap.pop();
+      assertUnit(heap.empty());
+   }  // teardown
+
+   // refilling spreads a bucket out below its bit, around the new last
+   void test_pop_refill()
+   {  // setup
+      custom::radix_heap <uint32_t, int> heap;
+      heap.push(0u, 0);
+      heap.push(12u, 12);
+      heap.push(13u, 13);
+      heap.push(15u, 15);
+      assertUnit(heap.buckets[4].size() == 3);
+      // exercise
+      heap.pop();
+      heap.top();
+      // verify
+      assertUnit(heap.last == 12u);
+      assertUnit(heap.buckets[4].empty());
+      assertUnit(heap.buckets[0].size() == 1);
+      assertUnit(heap.buckets[1].size() == 1);
+      assertUnit(heap.buckets[2].size() == 1);
+      assertUnit(heap.top() == 12);
+   }  // teardown
+
+   // float keys, negative ones too, come out in order
+   void test_pop_float()
+   {  // setup
+      custom::radix_heap <float, std::string> heap;
+      heap.push(2.5f, std::string("c"));
+      heap.push(-1.5f, std::string("a"));
+      heap.push(0.25f, std::string("b"));
+      heap.push(1e20f, std::string("d"));
+      std::string s;
+      // exercise
+      while (!heap.empty())
+         s += heap.pop_value();
+      // verify
+      assertUnit(s == std::string("abcd"));
+   }  // teardown
+
+   // a Dijkstra-like stream, every push at least the last pop, agrees
+   // with a priority_queue on the keys
+   void test_pop_monotone()
+   {  // setup
+      custom::radix_heap <uint64_t, uint32_t> heap;
+      custom::priority_queue <uint64_t, std::greater<uint64_t> > pq;
+      bool isSame = true;
+      uint64_t keyLast = 0;
+      // exercise
+      heap.push(uint64_t(0), 0u);
+      pq.push(0);
+      for (uint32_t i = 1; i < 5000 && !pq.empty(); i++)
+      {
+         isSame = isSame && heap.top_key() == pq.top();
+         keyLast = pq.pop_value();
+         heap.pop();
+         for (uint32_t j = 0; j < 3; j++)
+         {
+            uint64_t key = keyLast + (i * 7919 + j * 104729) % 1000 + (j == 2 ? 1000000000000ULL : 0);
+            heap.push(key, i);
+            pq.push(key);
+         }
+      }
+      // verify
+      assertUnit(isSame);
+      assertUnit(heap.size() == pq.size());
+      while (!pq.empty())
+      {
+         isSame = isSame && heap.top_key() == pq.pop_value();
+         heap.pop();
+      }
+      assertUnit(isSame);
+      assertUnit(heap.empty());
+   }  // teardown
+
+   // clear empties the heap, and any key may be pushed again
+   void test_clear()
+   {  // setup
+      custom::radix_heap <uint32_t, int> heap;
+      heap.push(50u, 50);
+      heap.push(70u, 70);
+      heap.top();
+      // exercise
+      heap.clear();
+      // verify
+      assertUnit(heap.empty());
+      assertUnit(heap.last == 0);
+      heap.push(3u, 3);
+      assertUnit(heap.top() == 3);
+   }  // teardown
+};
+
+#endif // DEBUG
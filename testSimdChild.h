@@ -0,0 +1,213 @@
+/***********************************************************************
+ * Header:
+ *    TEST SIMD CHILD
+ * Summary:
+ *    Unit tests for the vector search of a node's children
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "simd_child.h"       // class under test
+#include "priority_queue.h"   // the heap that uses it
+#include "unitTest.h"         // unit test baseclass
+
+#include <functional>
+#include <iostream>
+#include <string>
+
+
+class TestSimdChild : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Enabled
+      test_isEnabled_keys();
+      test_isEnabled_opaque();
+
+      // Best child
+#if defined(PQUEUE_SIMD_AVX2) || defined(PQUEUE_SIMD_SSE4)
+      test_best_int32();
+      test_best_int64();
+      test_best_float();
+      test_best_double();
+      test_best_ties();
+#endif
+
+      // Wide heap
+      test_pop_wide();
+
+      report("SimdChild");
+#if !defined(PQUEUE_SIMD_AVX2) && !defined(PQUEUE_SIMD_SSE4)
+      std::cerr << "\tskipped 5 best child tests: built without SSE4.2 or AVX2\n";
+#endif
+   }
+
+   /***************************************************
+    * INT LESS
+    * std::less by another name: the search cannot see
+    * through it, so it must stay scalar
+    ***************************************************/
+   struct IntLess
+   {
+      bool operator()(int lhs, int rhs) const { return lhs < rhs; }
+   };
+
+   /***************************************
+    * IS ENABLED
+    ***************************************/
+
+   // the four key types under less and greater, 8 or 16 children
+   void test_isEnabled_keys()
+   {  // setup
+      // exercise
+      // verify
+#if defined(PQUEUE_SIMD_AVX2) || defined(PQUEUE_SIMD_SSE4)
+      assertUnit((custom::simd_child<int,       std::less<int>,          16>::isEnabled));
+      assertUnit((custom::simd_child<long long, std::greater<long long>,  8>::isEnabled));
+      assertUnit((custom::simd_child<float,     std::less<float>,          8>::isEnabled));
+      assertUnit((custom::simd_child<double,    std::greater<double>,     16>::isEnabled));
+#endif
+      assertUnit(!(custom::simd_child<int,      std::less<int>,            4>::isEnabled));
+      assertUnit(!(custom::simd_child<unsigned, std::less<unsigned>,       8>::isEnabled));
+      assertUnit(!(custom::simd_child<short,    std::less<short>,          8>::isEnabled));
+   }  // teardown
+
+   // anything else the heap compares one child at a time
+   void test_isEnabled_opaque()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit(!(custom::simd_child<int, IntLess, 8>::isEnabled));
+      assertUnit(!(custom::simd_child<std::string, std::less<std::string>, 8>::isEnabled));
+   }  // teardown
+
+   /***************************************
+    * BEST
+    ***************************************/
+
+   // 16 int children, biggest first
+   void test_best_int32()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit((matchesScalar<int, std::less<int>, 16>()));
+      assertUnit((matchesScalar<int, std::greater<int>, 8>()));
+   }  // teardown
+
+   // 8 int64 children, values too big for 32 bits
+   void test_best_int64()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit((matchesScalar<long long, std::less<long long>, 8>(1000000007LL * 1000000007LL)));
+      assertUnit((matchesScalar<long long, std::greater<long long>, 16>(-1000000007LL * 1000000007LL)));
+   }  // teardown
+
+   // float children, some of them negative
+   void test_best_float()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit((matchesScalar<float, std::less<float>, 16>(-0.5f)));
+      assertUnit((matchesScalar<float, std::greater<float>, 8>(0.25f)));
+   }  // teardown
+
+   // double children, some of them negative
+   void test_best_double()
+   {  // setup
+      // exercise
+      // verify
+      assertUnit((matchesScalar<double, std::less<double>, 8>(-0.5)));
+      assertUnit((matchesScalar<double, std::greater<double>, 16>(0.25)));
+   }  // teardown
+
+   // the first of equal children wins
+   void test_best_ties()
+   {  // setup
+      int same[16] = {};
+      int twice[16] = { 1, 2, 3, 9, 4, 5, 6, 7, 8, 1, 2, 9, 0, 0, 0, 0 };
+      // exercise
+      // verify
+#if defined(PQUEUE_SIMD_AVX2) || defined(PQUEUE_SIMD_SSE4)
+      assertUnit((custom::simd_child<int, std::less<int>, 16>::best(same)) == 0);
+      assertUnit((custom::simd_child<int, std::less<int>, 16>::best(twice)) == 3);
+      assertUnit((custom::simd_child<int, std::greater<int>, 16>::best(twice)) == 12);
+#endif
+      assertUnit(same[0] == 0 && twice[3] == 9);
+   }  // teardown
+
+   /***************************************
+    * WIDE PRIORITY QUEUE
+    ***************************************/
+
+   // a wide heap pops in order, whatever searches the children
+   void test_pop_wide()
+   {  // setup
+      custom::wide_priority_queue<int> pqInt;
+      custom::wide_priority_queue<double, std::greater<double> > pqDouble;
+      custom::priority_queue<int, IntLess, 16> pqScalar;
+      // exercise
+      for (int i = 0; i < 1000; i++)
+      {
+         pqInt.push((i * 7919) % 1009);
+         pqDouble.push(double((i * 7919) % 1009) / 8.0);
+         pqScalar.push((i * 7919) % 1009);
+      }
+      // verify
+      bool isOrdered = true;
+      int    prevInt    = pqInt.top();
+      double prevDouble = pqDouble.top();
+      while (!pqInt.empty())
+      {
+         isOrdered = isOrdered && pqInt.top() <= prevInt && pqDouble.top() >= prevDouble &&
+                     pqInt.top() == pqScalar.top();
+         prevInt    = pqInt.pop_value();
+         prevDouble = pqDouble.pop_value();
+         pqScalar.pop();
+      }
+      assertUnit(isOrdered);
+      assertUnit(pqDouble.empty() && pqScalar.empty());
+   }  // teardown
+
+   /***************************************************
+    * MATCHES SCALAR
+    * On a thousand rows of children, with many ties,
+    * does the vector search pick the same child as
+    * the scalar loop? FALSE when there is no vector search.
+    ***************************************************/
+   template <class T, class Compare, size_t Arity>
+   bool matchesScalar(T scale = T(1))
+   {
+      if constexpr (!custom::simd_child<T, Compare, Arity>::isEnabled)
+         return false;
+      else
+      {
+         Compare compare;
+         T children[Arity];
+         for (int row = 0; row < 1000; row++)
+         {
+            for (size_t i = 0; i < Arity; i++)
+               children[i] = T((row * 31 + int(i) * 17) % 13 - 6) * scale;
+
+            size_t indexBest = 0;
+            for (size_t i = 1; i < Arity; i++)
+               if (compare(children[indexBest], children[i]))
+                  indexBest = i;
+
+            if (custom::simd_child<T, Compare, Arity>::best(children) != indexBest)
+               return false;
+         }
+         return true;
+      }
+   }
+};
+
+#endif // DEBUG
@@ -0,0 +1,213 @@
+/***********************************************************************
+ * Header:
+ *    TEST SPLIT PRIORITY QUEUE
+ * Summary:
+ *    Unit tests for the split priority queue
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "split_priority_queue.h"  // class under test
+#include "unitTest.h"              // unit test baseclass
+#include "spy.h"
+
+#include <functional>
+#include <string>
+
+
+class TestSplitPQueue : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Insert
+      test_push_standard();
+      test_push_spy();
+
+      // Remove
+      test_pop_standard();
+      test_pop_greater();
+      test_pop_spy();
+      test_pop_recycle();
+      test_popValue_spy();
+
+      report("SplitPQ");
+   }
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::split_priority_queue <int, std::string> pq;
+      // verify
+      assertUnit(pq.empty());
+      assertUnit(pq.size() == 0);
+      assertUnit(pq.payloads.size() == 0);
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // push the standard fixture: the best key is on top with its payload
+   void test_push_standard()
+   {  // setup
+      custom::split_priority_queue <int, std::string> pq;
+      // exercise
+      setupStandardFixture(pq);
+      // verify
+      assertUnit(pq.size() == 7);
+      assertUnit(pq.payloads.size() == 7);
+      assertUnit(pq.top_key() == 10);
+      assertUnit(pq.top() == std::string("ten"));
+   }  // teardown
+
+   // a payload is moved into its slot once, and never again while sifting
+   void test_push_spy()
+   {  // setup
+      custom::split_priority_queue <int, Spy> pq;
+      for (int key = 0; key < 10; key++)
+         pq.push(key, Spy(key));
+      Spy::reset();
+      // exercise
+      for (int key = 10; key < 20; key++)
+         pq.push(key, Spy(key));
+      // verify
+      //   each push: one Spy(int), one move into its slot;
+      //   the payloads array doubles once, from 16 to 32 slots
+      assertUnit(Spy::numNondefault() == 10);
+      assertUnit(Spy::numAssignMove() == 10 + 16);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(pq.top().get() == 19);
+   }  // teardown
+
+   /***************************************
+    * POP
+    ***************************************/
+
+   // pop hands out the payloads in key order
+   void test_pop_standard()
+   {  // setup
+      custom::split_priority_queue <int, std::string> pq;
+      setupStandardFixture(pq);
+      // exercise
+      std::string payloads = popAll(pq);
+      // verify
+      assertUnit(payloads == std::string("ten nine eight seven five four three "));
+      assertUnit(pq.freeSlots.size() == 7);
+   }  // teardown
+
+   // the smallest key first with std::greater
+   void test_pop_greater()
+   {  // setup
+      custom::split_priority_queue <int, std::string, std::greater<int> > pq;
+      setupStandardFixture(pq);
+      // exercise
+      std::string payloads = popAll(pq);
+      // verify
+      assertUnit(payloads == std::string("three four five seven eight nine ten "));
+   }  // teardown
+
+   // pop touches only the payload that leaves
+   void test_pop_spy()
+   {  // setup
+      custom::split_priority_queue <int, Spy> pq;
+      for (int key = 0; key < 100; key++)
+         pq.push((key * 37) % 100, Spy(key));
+      Spy::reset();
+      // exercise
+      pq.pop();
+      // verify
+      //   one default Spy assigned over the popped payload
+      assertUnit(Spy::numDefault() == 1);
+      assertUnit(Spy::numAssignMove() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numLessthan() == 0);
+      assertUnit(pq.size() == 99);
+      assertUnit(pq.top_key() == 98);
+   }  // teardown
+
+   // a popped payload's slot is given to the next push
+   void test_pop_recycle()
+   {  // setup
+      custom::split_priority_queue <int, std::string> pq;
+      pq.push(1, std::string("one"));
+      pq.push(2, std::string("two"));
+      pq.pop();
+      // exercise
+      pq.push(3, std::string("three"));
+      // verify
+      assertUnit(pq.payloads.size() == 2);
+      assertUnit(pq.freeSlots.size() == 0);
+      assertUnit(pq.payloads[1] == std::string("three"));
+      assertUnit(popAll(pq) == std::string("three one "));
+   }  // teardown
+
+   // pop_value moves the payload out
+   void test_popValue_spy()
+   {  // setup
+      custom::split_priority_queue <int, Spy> pq;
+      pq.push(5, Spy(50));
+      pq.push(9, Spy(90));
+      Spy::reset();
+      // exercise
+      Spy spy = pq.pop_value();
+      // verify
+      assertUnit(spy.get() == 90);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(pq.size() == 1);
+      assertUnit(pq.top().get() == 50);
+   }  // teardown
+
+   /***************************************************
+    * SETUP STANDARD FIXTURE
+    *               10
+    *         8            9
+    *      4     3      7     5
+    * each with its name as the payload
+    ***************************************************/
+   template <class Compare>
+   void setupStandardFixture(custom::split_priority_queue <int, std::string, Compare> & pq)
+   {
+      const char * names[] = { "zero", "one", "two", "three", "four", "five",
+                               "six", "seven", "eight", "nine", "ten" };
+      for (int key : { 10, 8, 9, 4, 3, 7, 5 })
+         pq.push(key, std::string(names[key]));
+   }
+
+   /***************************************************
+    * POP ALL
+    * Empty the queue, spelling out the payloads in order
+    ***************************************************/
+   template <class Compare>
+   std::string popAll(custom::split_priority_queue <int, std::string, Compare> & pq)
+   {
+      std::string payloads;
+      while (!pq.empty())
+      {
+         payloads += pq.top() + " ";
+         pq.pop();
+      }
+      return payloads;
+   }
+};
+
+#endif // DEBUG
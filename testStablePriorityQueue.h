@@ -0,0 +1,247 @@
+/***********************************************************************
+ * Header:
+ *    TEST STABLE PRIORITY QUEUE
+ * Summary:
+ *    Unit tests for the stable priority queue
+ * Author
+ *    Joel Jossie, Gergo Medveczky
+ ************************************************************************/
+
+#pragma once
+
+#ifdef DEBUG
+
+#include "stable_priority_queue.h"  // class under test
+#include "unitTest.h"               // unit test baseclass
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+
+class TestStablePQueue : public UnitTest
+{
+
+public:
+   void run()
+   {
+      reset();
+
+      // Construct
+      test_construct_default();
+
+      // Access
+      test_top_empty();
+
+      // Insert
+      test_push_ties();
+      test_push_tiesPacked();
+      test_push_tiesPackedMin();
+      test_push_tiesPackedFloat();
+      test_push_resequence();
+
+      // Remove
+      test_popValue_ties();
+
+      report("StablePQ");
+   }
+
+   /***************************************************
+    * JOB
+    * A priority and a name. Jobs of the same priority
+    * are told apart only by their names.
+    ***************************************************/
+   struct Job
+   {
+      int priority;
+      std::string name;
+   };
+
+   struct JobPriority
+   {
+      int operator()(const Job & job) const { return job.priority; }
+   };
+
+   // the hand-written comparator, which cannot be packed
+   struct JobLess
+   {
+      bool operator()(const Job & lhs, const Job & rhs) const { return lhs.priority < rhs.priority; }
+   };
+
+   // a level read off a sensor, ordered by level
+   struct Reading
+   {
+      float level;
+      char name;
+   };
+
+   struct ReadingLevel
+   {
+      float operator()(const Reading & reading) const { return reading.level; }
+   };
+
+   /***************************************
+    * CONSTRUCTOR
+    ***************************************/
+
+   // default constructor
+   void test_construct_default()
+   {  // setup
+      // exercise
+      custom::stable_priority_queue <Job, JobLess> pq;
+      // verify
+      assertUnit(pq.empty());
+      assertUnit(pq.size() == 0);
+      assertUnit(pq.sequence == 0);
+   }  // teardown
+
+   /***************************************
+    * TOP
+    ***************************************/
+
+   // top of an empty queue throws
+   void test_top_empty()
+   {  // setup
+      custom::stable_priority_queue <Job, custom::compare_by<JobPriority> > pq;
+      // exercise
+      try
+      {
+         pq.top();
+         // verify
+         assertUnit(false);
+      }
+      catch (const char * error)
+      {
+         assertUnit(std::string(error) == std::string("std:out_of_range"));
+      }
+   }  // teardown
+
+   /***************************************
+    * PUSH
+    ***************************************/
+
+   // equal priorities come off in the order they were pushed
+   void test_push_ties()
+   {  // setup
+      custom::stable_priority_queue <Job, JobLess> pq;
+      // exercise
+      pushJobs(pq);
+      // verify
+      assertUnit(pq.size() == 7);
+      assertUnit(pq.sequence == 7);
+      assertUnit(popNames(pq) == std::string("bdgeacf"));
+   }  // teardown
+
+   // the same with the key packed next to the sequence number
+   void test_push_tiesPacked()
+   {  // setup
+      typedef custom::stable_priority_queue <Job, custom::compare_by<JobPriority> > PQ;
+      PQ pq;
+      // exercise
+      pushJobs(pq);
+      // verify
+      assertUnit(sizeof(PQ::entry) == sizeof(uint64_t) + sizeof(Job));
+      assertUnit(pq.size() == 7);
+      assertUnit(popNames(pq) == std::string("bdgeacf"));
+   }  // teardown
+
+   // smallest priority on top, still oldest first among ties
+   void test_push_tiesPackedMin()
+   {  // setup
+      custom::stable_priority_queue <Job, custom::compare_by<JobPriority, std::greater<void> > > pq;
+      // exercise
+      pq.push(Job{ -1, "a" });
+      pq.push(Job{  2, "b" });
+      pq.push(Job{ -1, "c" });
+      pq.push(Job{ -5, "d" });
+      pq.push(Job{  2, "e" });
+      // verify
+      assertUnit(popNames(pq) == std::string("dacbe"));
+   }  // teardown
+
+   // a float key is packed too, with -0 tying +0
+   void test_push_tiesPackedFloat()
+   {  // setup
+      typedef custom::stable_priority_queue <Reading, custom::compare_by<ReadingLevel> > PQ;
+      PQ pq;
+      // exercise
+      pq.push(Reading{ -1.5f,  'a' });
+      pq.push(Reading{  0.0f,  'b' });
+      pq.push(Reading{  2.25f, 'c' });
+      pq.push(Reading{ -0.0f,  'd' });
+      pq.push(Reading{ -1.5f,  'e' });
+      pq.push(Reading{ -7.0f,  'f' });
+      pq.push(Reading{  2.25f, 'g' });
+      // verify
+      assertUnit(sizeof(PQ::entry) == sizeof(uint64_t) + sizeof(Reading));
+      std::string names;
+      while (!pq.empty())
+         names += pq.pop_value().name;
+      assertUnit(names == std::string("cgbdaef"));
+   }  // teardown
+
+   // running out of sequence numbers renumbers without losing the order
+   void test_push_resequence()
+   {  // setup
+      custom::stable_priority_queue <Job, custom::compare_by<JobPriority> > pq;
+      pq.sequence = UINT32_MAX - 2;
+      // exercise
+      pq.push(Job{ 1, "a" });
+      pq.push(Job{ 3, "b" });
+      pq.push(Job{ 1, "c" });
+      pq.push(Job{ 3, "d" });
+      pq.push(Job{ 1, "e" });
+      // verify
+      assertUnit(pq.sequence == 5);
+      assertUnit(popNames(pq) == std::string("bdace"));
+   }  // teardown
+
+   /***************************************
+    * POP VALUE
+    ***************************************/
+
+   // pop_value hands the jobs out oldest first among ties
+   void test_popValue_ties()
+   {  // setup
+      custom::stable_priority_queue <Job, custom::compare_by<JobPriority> > pq;
+      pq.push(Job{ 2, "first" });
+      pq.push(Job{ 2, "second" });
+      // exercise
+      Job job = pq.pop_value();
+      // verify
+      assertUnit(job.name == std::string("first"));
+      assertUnit(pq.size() == 1);
+      assertUnit(pq.top().name == std::string("second"));
+   }  // teardown
+
+   /***************************************************
+    * PUSH JOBS
+    * Priorities 1 3 1 3 2 1 3, named a through g
+    ***************************************************/
+   template <class PQ>
+   void pushJobs(PQ & pq)
+   {
+      const char * names = "abcdefg";
+      int priorities[] = { 1, 3, 1, 3, 2, 1, 3 };
+      for (int i = 0; i < 7; i++)
+         pq.push(Job{ priorities[i], std::string(1, names[i]) });
+   }
+
+   /***************************************************
+    * POP NAMES
+    * Empty the queue, spelling out the names in order
+    ***************************************************/
+   template <class PQ>
+   std::string popNames(PQ & pq)
+   {
+      std::string names;
+      while (!pq.empty())
+      {
+         names += pq.top().name;
+         pq.pop();
+      }
+      return names;
+   }
+};
+
+#endif // DEBUG
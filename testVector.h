@@ -14,6 +14,7 @@
 #include <vector>
 #include "vector.h"
 #include "unitTest.h"
+#include "spy.h"
 
 
 #include <cassert>
@@ -86,6 +87,8 @@ public:
       test_pushback_moveEmpty();
       test_pushback_moveExcessCapacity();
       test_pushback_moveRequireReallocate();
+      test_emplaceback_empty();
+      test_emplaceback_excessCapacity();
       test_resize_emptyZero();
       test_resize_emptyFourDefault();
       test_resize_emptyFourValue();
@@ -1812,6 +1815,57 @@ public:
    }
    
    
+   // construct an element in place on an empty vector
+   void test_emplaceback_empty()
+   {  // setup
+      custom::vector<int> v;
+      // exercise
+      v.emplace_back(99);
+      // verify
+      //      0
+      //    +----+
+      //    | 99 |
+      //    +----+
+      assertUnit(v.data != nullptr);
+      if (v.data)
+         assertUnit(v.data[0] == int(99));
+      assertUnit(v.numCapacity == 1);
+      assertUnit(v.numElements == 1);
+      // teardown
+      teardownStandardFixture(v);
+   }
+
+   // construct an element in place: no copy, no move, no assignment
+   void test_emplaceback_excessCapacity()
+   {  // setup
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 |    |    |
+      //    +----+----+----+----+
+      custom::vector<Spy> v;
+      v.reserve(4);
+      v.push_back(Spy(26));
+      v.push_back(Spy(49));
+      Spy::reset();
+      // exercise
+      v.emplace_back(67);
+      // verify
+      //      0    1    2    3
+      //    +----+----+----+----+
+      //    | 26 | 49 | 67 |    |
+      //    +----+----+----+----+
+      assertUnit(Spy::numNondefault() == 1);
+      assertUnit(Spy::numCopy() == 0);
+      assertUnit(Spy::numCopyMove() == 0);
+      assertUnit(Spy::numAssign() == 0);
+      assertUnit(Spy::numAssignMove() == 0);
+      assertUnit(Spy::numDestructor() == 1);   // the empty slot
+      assertUnit(v.numCapacity == 4);
+      assertUnit(v.numElements == 3);
+      if (v.numElements == 3)
+         assertUnit(v.data[2] == Spy(67));
+   }  // teardown
+
    /***************************************
     * ITERATOR
     ***************************************/
@@ -24,6 +24,7 @@
 #include <cassert>  // because I am paranoid
 #include <new>      // std::bad_alloc
 #include <memory>   // for std::allocator
+#include <type_traits> // for std::is_nothrow_default_constructible
 #include <iostream> // DELETE ME
 
 class TestVector; // forward declaration for unit tests
@@ -97,6 +98,8 @@ namespace custom
 
       void push_back(const T &t);
       void push_back(T &&t);
+      template <class ... Args>
+      void emplace_back(Args && ... args);
       void reserve(size_t newCapacity);
       void resize (size_t newElements);
       void resize (size_t newElements, const T &t);
@@ -358,7 +361,7 @@ namespace custom
 /***************************************
  * VECTOR :: RESERVE
  * This method will grow the current buffer
- * to newCapacity.  It will also copy all
+ * to newCapacity.  It will also move all
  * the data from the old buffer into the new
  *     INPUT  : newCapacity the size of the new buffer
  *     OUTPUT :
@@ -372,11 +375,11 @@ namespace custom
       {
          // Make a new buffer
          auto newData = new T[newCapacity];
-         // Copy over the old values
-         for (int i = 0; i < numElements; i++)
-            newData[i] = data[i];
+         // Move over the old values
+         for (size_t i = 0; i < numElements; i++)
+            newData[i] = std::move(data[i]);
          // Remove the old buffer
-         delete data;
+         delete [] data;
          data = newData;
          numCapacity = newCapacity;
       }
@@ -479,6 +482,40 @@ namespace custom
       data[numElements++] = std::move(t);
    }
 
+/***************************************
+ * VECTOR :: EMPLACE BACK
+ * This method will construct a new element at the
+ * end of the current buffer directly from 'args',
+ * with no temporary to copy or move.  The slot holds
+ * a default-constructed element, so end its life first.
+ * Every slot of the buffer must hold a live element,
+ * so if the constructor throws, the slot is refilled
+ * with T(), which therefore must not throw.
+ *     INPUT  : 'args' the constructor parameters
+ *     OUTPUT :
+ **************************************/
+   template<typename T>
+   template<class ... Args>
+   void vector<T>::emplace_back(Args && ... args)
+   {
+      static_assert(std::is_nothrow_default_constructible<T>::value,
+                    "emplace_back refills a slot with T() when construction fails");
+      if (numElements == numCapacity)
+         reserve(nextCapacity());
+      T * p = data + numElements;
+      p->~T();
+      try
+      {
+         new (p) T(std::forward<Args>(args)...);
+      }
+      catch (...)
+      {
+         new (p) T;  // the buffer still owns a live element here
+         throw;
+      }
+      numElements++;
+   }
+
 /***************************************
  * VECTOR :: ASSIGNMENT
  * This operator will copy the contents of the
@@ -500,12 +537,14 @@ namespace custom
    template<typename T>
    vector<T> &vector<T>::operator=(vector &&rhs)
    {
-      clear();
-      for (int i = 0; i < rhs.size(); i++)
-      {
-         push_back(rhs.data[i]);
-      }
-      std::swap(numCapacity, rhs.numCapacity);
+      if (this == &rhs)
+         return *this;
+
+      // take the buffer rather than copying out of it
+      delete [] data;
+      data        = rhs.data;
+      numCapacity = rhs.numCapacity;
+      numElements = rhs.numElements;
 
       rhs.numCapacity = 0;
       rhs.numElements = 0;